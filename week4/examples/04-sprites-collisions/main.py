@@ -1,32 +1,267 @@
+import argparse
+import functools
+import logging
+import os
+import tempfile
+import time
+
 import pygame
 
+from sprites_collisions import levels, streaming, trace
+from sprites_collisions.capture import FrameCapture
 from sprites_collisions.game import Game
+from sprites_collisions.gcpolicy import GcPolicy
+from sprites_collisions.heatmap import Heatmap
+from sprites_collisions.perf import SessionReport
+from sprites_collisions.pipeline import SimulationThread, SnapshotBuffer
+
+
+def parse_args() -> argparse.Namespace:
+    parser = argparse.ArgumentParser(description="Week 4 Sprites + Collisions")
+    parser.add_argument("--autoplay", action="store_true", help="let the A* bot play (soak testing)")
+    parser.add_argument("--headless", action="store_true", help="dummy video/audio drivers, no window")
+    parser.add_argument("--duration", type=float, default=0.0, help="quit after this many seconds (0 = never)")
+    parser.add_argument("--level", choices=("arena", "tiled", "generated"), default="arena", help="level layout")
+    parser.add_argument("--tiles", default="4x4", help="COLSxROWS arena copies for --level tiled")
+    parser.add_argument(
+        "--counts", default="2000,500,200", help="WALLS,COINS,HAZARDS for --level generated (laid out from --seed)"
+    )
+    parser.add_argument("--ecs", action="store_true", help="run level objects on the column-store ECS core")
+    parser.add_argument("--stream", action="store_true", help="bake the level into chunks and stream them from disk")
+    parser.add_argument("--chunk-size", type=int, default=1024, help="chunk edge in pixels for --stream")
+    parser.add_argument(
+        "--renderer", choices=("surface", "texture"), default="surface", help="software Surface or SDL2 Renderer/Texture backend"
+    )
+    parser.add_argument("--render-scale", type=float, default=1.0, help="internal pixels per logical pixel (0.5 = quarter fill)")
+    parser.add_argument("--window", default=None, help="WxH window size; the frame is scaled to fit (default: logical size)")
+    parser.add_argument("--smooth", action="store_true", help="bilinear upscale instead of nearest-neighbour")
+    parser.add_argument("--governor", action="store_true", help="lower render quality automatically when frames run over budget")
+    parser.add_argument("--budget-ms", type=float, default=0.0, help="frame work budget for --governor (default: one frame at the target fps)")
+    parser.add_argument("--seed", type=int, default=None, help="seed for the game and autopilot RNGs (repeatable runs)")
+    parser.add_argument("--pipelined", action="store_true", help="simulate on a worker thread; the main thread renders")
+    parser.add_argument("--log-every", type=float, default=60.0, help="seconds between frame stat log lines")
+    parser.add_argument("--trace", default=None, help="record frame phases; write Chrome trace JSON here on exit (F9 dumps a copy)")
+    parser.add_argument(
+        "--gc", choices=("auto", "idle"), default="auto", help="idle: freeze each level, collect only in the slack after a frame"
+    )
+    parser.add_argument("--report", default=None, help="write a JSON session performance report (histograms, missed vsync) here on exit")
+    parser.add_argument("--capture", default=None, help="record frames into this folder (mp4 via ffmpeg if on PATH, else PNGs; F12: screenshot)")
+    parser.add_argument("--capture-every", type=int, default=1, help="record every Nth frame with --capture")
+    parser.add_argument("--capture-pool", type=int, default=8, help="frames that may wait for the writer before new ones are dropped")
+    parser.add_argument("--heatmap", default=None, help="write player time/damage/coin heatmaps to STEM.npz and STEM.png on exit")
+    parser.add_argument("--trace-minutes", type=float, default=60.0, help="how much trace history --trace keeps")
+    return parser.parse_args()
 
 
 def main() -> None:
+    args = parse_args()
+    if args.headless:
+        os.environ["SDL_VIDEODRIVER"] = "dummy"
+        os.environ["SDL_AUDIODRIVER"] = "dummy"
+
     pygame.init()
     #Mixer is initalized for Sound Effects
     pygame.mixer.init()
     pygame.display.set_caption("Week 4 Sprites + Collisions (Pygame)")
 
-    game = Game()
+    level = levels.arena
+    # Names the layout in heatmaps, so runs of the same one merge
+    layout = "arena"
+    if args.level == "tiled":
+        cols, rows = (int(n) for n in args.tiles.lower().split("x"))
+        level = functools.partial(levels.tiled, cols=cols, rows=rows)
+        layout = f"tiled-{cols}x{rows}"
+    elif args.level == "generated":
+        walls, coins, hazards = (int(n) for n in args.counts.split(","))
+        level = functools.partial(levels.generated, walls=walls, coins=coins, hazards=hazards, seed=args.seed or 0)
+        layout = f"generated-{walls}-{coins}-{hazards}-seed{args.seed or 0}"
+
+    chunk_dir = None
+    spec = None
+    if args.stream:
+        # A real build would ship pre-baked chunks; baking here keeps the demo self-contained.
+        # Removed at exit (or by its finalizer if the run dies first).
+        chunk_dir = tempfile.TemporaryDirectory(prefix="sprites-chunks-", ignore_cleanup_errors=True)
+        spec = level(Game.playfield_rect())
+        streaming.bake(spec, chunk_dir.name, chunk=args.chunk_size)
+        level = streaming.open_level(chunk_dir.name)
+
+    window = tuple(int(n) for n in args.window.lower().split("x")) if args.window else None
+    tracer = trace.OFF
+    if args.trace:
+        tracer = trace.Tracer(args.trace, capacity=trace.capacity_for(args.trace_minutes, Game.fps))
+    # Made before the game so the first level load is frozen too
+    gc_policy = GcPolicy(args.gc)
+    game = Game(
+        level=level,
+        use_ecs=args.ecs,
+        renderer=args.renderer,
+        render_scale=args.render_scale,
+        window=window,
+        smooth=args.smooth,
+        seed=args.seed,
+        tracer=tracer,
+        gc_policy=gc_policy,
+    )
     clock = pygame.time.Clock()
 
-    running = True
-    while running:
-        dt = clock.tick(game.fps) / 1000.0
-        dt = min(dt, 0.05)
+    report = SessionReport(fps=game.fps) if args.report else None
+
+    if args.autoplay or args.governor or args.trace or args.report or args.capture or args.heatmap:
+        logging.basicConfig(level=logging.INFO, format="%(asctime)s %(message)s")
+
+    if args.capture:
+        game.capture = FrameCapture(
+            args.capture, game.canvas.size, recording=True, every=args.capture_every, pool=args.capture_pool, fps=game.fps
+        )
+
+    if args.heatmap:
+        # A streamed level only holds the chunks paged in so far; the spec has every wall
+        outline = spec.walls if spec is not None else [tuple(w.rect) for w in game.walls]
+        game.telemetry = Heatmap(layout, game.world, walls=outline)
+
+    governor = None
+    if args.governor:
+        from sprites_collisions.quality import QualityGovernor
+
+        governor = QualityGovernor(game, budget_ms=args.budget_ms or 1000.0 / game.fps)
+
+    stats = None
+    if args.autoplay:
+        from sprites_collisions.autoplay import AutoPilot
+        from sprites_collisions.perf import FrameStats
 
-        for event in pygame.event.get():
-            if event.type == pygame.QUIT:
+        game.autopilot = AutoPilot(seed=args.seed or 0)
+        stats = FrameStats()
+        restart = pygame.event.Event(pygame.KEYDOWN, key=pygame.K_SPACE)
+        runs = {"win": 0, "gameover": 0}
+
+    started = time.perf_counter()
+    next_log = started + args.log_every
+
+    def step(dt: float, input_time: float):
+        if stats is not None and game.state != "play":
+            if game.state in runs:
+                runs[game.state] += 1
+            game.handle_event(restart)
+        start = time.perf_counter()
+        with tracer.span("update"):
+            game.update(dt)
+        if report is not None:
+            report.update.record(time.perf_counter() - start)
+        with tracer.span("snapshot"):
+            return game.snapshot(input_time)
+
+    def record(frame_s: float, work_s: float) -> None:
+        nonlocal next_log
+        if stats is None:
+            return
+        stats.add(frame_s, work_s)
+        now = time.perf_counter()
+        if now >= next_log:
+            next_log = now + args.log_every
+            summary = " ".join(f"{k}={v:.4g}" for k, v in (stats.summary() | gc_policy.summary()).items())
+            logging.info("%s sprites=%d wins=%d deaths=%d", summary, len(game.all_sprites), runs["win"], runs["gameover"])
+
+    def present(snap) -> None:
+        start = time.perf_counter()
+        game.present(snap)
+        if report is not None:
+            now = time.perf_counter()
+            report.draw.record(now - start)
+            report.presented(now)
+        if governor is not None and args.pipelined:
+            # Only rendering runs here; the simulation has its own thread
+            governor.observe(time.perf_counter() - start)
+        if stats is not None:
+            stats.add_latency(time.perf_counter() - snap.input_time)
+
+    def idle(deadline: float) -> None:
+        with tracer.span("gc.idle"):
+            gc_policy.idle(deadline)
+
+    if args.pipelined:
+        buffer = SnapshotBuffer()
+        sim = SimulationThread(game.handle_event, step, buffer, fps=game.fps, on_tick=record, on_idle=idle)
+        sim.start()
+        seq = 0
+        running = True
+        while running:
+            for event in pygame.event.get():
+                if event.type == pygame.QUIT:
+                    running = False
+                else:
+                    sim.post(event)
+
+            seq, snap = buffer.wait_newer(seq, timeout=0.1)
+            if snap is not None:
+                present(snap)
+
+            if sim.error is not None:
+                raise sim.error
+            if args.duration and time.perf_counter() - started >= args.duration:
                 running = False
-            else:
-                game.handle_event(event)
+        sim.stop()
+        sim.join()
+    else:
+        running = True
+        while running:
+            dt = clock.tick(game.fps) / 1000.0
+            frame_s = dt
+            dt = min(dt, 0.05)
+            work_start = time.perf_counter()
+
+            with tracer.span("frame"):
+                for event in pygame.event.get():
+                    if event.type == pygame.QUIT:
+                        running = False
+                    else:
+                        game.handle_event(event)
 
-        game.update(dt)
-        game.draw()
-        pygame.display.flip()
+                present(step(dt, work_start))
+            work_s = time.perf_counter() - work_start
+            record(frame_s, work_s)
+            if governor is not None:
+                governor.observe(work_s)
+            # Before clock.tick sleeps off the rest of the frame
+            idle(work_start + 1.0 / game.fps)
+
+            if args.duration and time.perf_counter() - started >= args.duration:
+                running = False
 
+    tracer.dump(args.trace, wait=True)
+    if game.capture is not None:
+        game.capture.close()
+    if game.telemetry is not None:
+        npz, png = game.telemetry.save(args.heatmap)
+        logging.info("heatmap: %s, %s", npz, png)
+    if report is not None:
+        # Streamed levels count what was paged in at exit
+        report.write(
+            args.report,
+            level={
+                "name": args.level,
+                "tiles": args.tiles if args.level == "tiled" else None,
+                "counts": args.counts if args.level == "generated" else None,
+                "stream": args.stream,
+                "world": list(game.world.size),
+            },
+            mode={"ecs": args.ecs, "pipelined": args.pipelined, "renderer": args.renderer, "render_scale": args.render_scale, "gc": args.gc},
+            objects={
+                "sprites": len(game.all_sprites),
+                "walls": len(game.walls),
+                "coins": len(game.coins),
+                "hazards": len(game.hazards),
+                "goals": len(game.goals),
+            },
+            gc=gc_policy.summary(),
+            capture=game.capture.summary() if game.capture is not None else None,
+        )
+    if chunk_dir is not None:
+        # Write-backs of evicted chunks land in the directory; let them finish first
+        if game.streamer is not None:
+            game.streamer.close()
+        chunk_dir.cleanup()
     pygame.quit()
 
 
@@ -0,0 +1,20 @@
+"""Optional native kernels: python3 setup.py build_ext --inplace
+
+The game runs without them; sprites_collisions.ecs falls back to Python.
+"""
+
+from setuptools import Extension, setup
+
+setup(
+    name="sprites_collisions",
+    packages=["sprites_collisions"],
+    ext_modules=[
+        Extension(
+            "sprites_collisions._kernel",
+            sources=["sprites_collisions/_kernel.cpp"],
+            language="c++",
+            extra_compile_args=["-O2", "-std=c++17"],
+            optional=True,
+        )
+    ],
+)
@@ -0,0 +1,305 @@
+// Native versions of the hot ECS systems (see ecs.py for the reference Python).
+//
+// Every function takes the ecs.World itself and works on its array.array
+// columns in place through the buffer protocol. Results must match the Python
+// systems exactly, including Python's round-half-to-even and float modulo.
+//
+// Build: python3 setup.py build_ext --inplace
+
+#define PY_SSIZE_T_CLEAN
+#include <Python.h>
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace {
+
+// RAII view of one World column, checked against the expected typecode.
+template <typename T>
+class Column {
+public:
+    Column(PyObject* world, const char* name, char code) {
+        PyObject* obj = PyObject_GetAttrString(world, name);
+        if (obj == nullptr) {
+            return;
+        }
+        int rc = PyObject_GetBuffer(obj, &view_, PyBUF_WRITABLE | PyBUF_FORMAT);
+        Py_DECREF(obj);
+        if (rc != 0) {
+            return;
+        }
+        held_ = true;
+        if (view_.itemsize != static_cast<Py_ssize_t>(sizeof(T)) || view_.format == nullptr ||
+            view_.format[0] != code || view_.format[1] != '\0') {
+            PyErr_Format(PyExc_TypeError, "World.%s: expected array('%c') of %zu-byte items", name, code,
+                         sizeof(T));
+            return;
+        }
+        ok_ = true;
+    }
+
+    ~Column() {
+        if (held_) {
+            PyBuffer_Release(&view_);
+        }
+    }
+
+    Column(const Column&) = delete;
+    Column& operator=(const Column&) = delete;
+
+    bool ok() const { return ok_; }
+    Py_ssize_t size() const { return view_.len / view_.itemsize; }
+    T& operator[](Py_ssize_t i) { return static_cast<T*>(view_.buf)[i]; }
+
+private:
+    Py_buffer view_{};
+    bool held_ = false;
+    bool ok_ = false;
+};
+
+// Rows a system walks: every row, or the ids in an optional sequence (None = all).
+class Rows {
+public:
+    Rows(PyObject* rows, Py_ssize_t n) : n_(n) {
+        if (rows == Py_None) {
+            count_ = n;
+            ok_ = true;
+            return;
+        }
+        seq_ = PySequence_Fast(rows, "rows must be a sequence of row ids");
+        if (seq_ == nullptr) {
+            return;
+        }
+        count_ = PySequence_Fast_GET_SIZE(seq_);
+        ok_ = true;
+    }
+
+    ~Rows() { Py_XDECREF(seq_); }
+
+    Rows(const Rows&) = delete;
+    Rows& operator=(const Rows&) = delete;
+
+    bool ok() const { return ok_; }
+    Py_ssize_t size() const { return count_; }
+
+    // Row id of the i-th entry, or -1 with an exception set.
+    Py_ssize_t operator[](Py_ssize_t i) const {
+        if (seq_ == nullptr) {
+            return i;
+        }
+        Py_ssize_t e = PyLong_AsSsize_t(PySequence_Fast_GET_ITEM(seq_, i));
+        if (e == -1 && PyErr_Occurred()) {
+            return -1;
+        }
+        if (e < 0 || e >= n_) {
+            PyErr_SetString(PyExc_IndexError, "entity out of range");
+            return -1;
+        }
+        return e;
+    }
+
+private:
+    PyObject* seq_ = nullptr;
+    Py_ssize_t n_;
+    Py_ssize_t count_ = 0;
+    bool ok_ = false;
+};
+
+// Python's round() on floats: ties go to even, as nearbyint does in the default mode.
+inline long py_round(double v) { return static_cast<long>(std::nearbyint(v)); }
+
+// Python's float %: the result takes the sign of the divisor.
+inline double py_mod(double a, double b) {
+    double r = std::fmod(a, b);
+    if (r != 0.0 && ((r < 0.0) != (b < 0.0))) {
+        r += b;
+    }
+    return r;
+}
+
+inline bool overlap(long ax, long ay, long aw, long ah, long bx, long by, long bw, long bh) {
+    return ax < bx + bw && bx < ax + aw && ay < by + bh && by < ay + ah;
+}
+
+PyObject* move_axis(PyObject*, PyObject* args) {
+    PyObject* world;
+    Py_ssize_t eid;
+    int axis;
+    double amount;
+    PyObject* candidates = Py_None;
+    if (!PyArg_ParseTuple(args, "Onid|O", &world, &eid, &axis, &amount, &candidates)) {
+        return nullptr;
+    }
+
+    Column<int32_t> xs(world, "x", 'i'), ys(world, "y", 'i'), ws(world, "w", 'i'), hs(world, "h", 'i');
+    Column<uint8_t> alive(world, "alive", 'B'), solid(world, "solid", 'B');
+    if (!xs.ok() || !ys.ok() || !ws.ok() || !hs.ok() || !alive.ok() || !solid.ok()) {
+        return nullptr;
+    }
+    const Py_ssize_t n = xs.size();
+    if (eid < 0 || eid >= n) {
+        PyErr_SetString(PyExc_IndexError, "entity out of range");
+        return nullptr;
+    }
+
+    Rows rows(candidates, n);
+    if (!rows.ok()) {
+        return nullptr;
+    }
+
+    const long step = py_round(amount);
+    if (axis == 0) {
+        xs[eid] += step;
+    } else {
+        ys[eid] += step;
+    }
+
+    const long px = xs[eid], py = ys[eid], pw = ws[eid], ph = hs[eid];
+    std::vector<Py_ssize_t> hits;
+    for (Py_ssize_t i = 0; i < rows.size(); ++i) {
+        const Py_ssize_t s = rows[i];
+        if (s < 0) {
+            return nullptr;
+        }
+        if (solid[s] && alive[s] && s != eid && overlap(px, py, pw, ph, xs[s], ys[s], ws[s], hs[s])) {
+            hits.push_back(s);
+        }
+    }
+    for (Py_ssize_t s : hits) {
+        if (axis == 0) {
+            if (amount > 0) {
+                xs[eid] = xs[s] - pw;
+            } else if (amount < 0) {
+                xs[eid] = xs[s] + ws[s];
+            }
+        } else {
+            if (amount > 0) {
+                ys[eid] = ys[s] - ph;
+            } else if (amount < 0) {
+                ys[eid] = ys[s] + hs[s];
+            }
+        }
+    }
+    Py_RETURN_NONE;
+}
+
+PyObject* overlaps(PyObject*, PyObject* args) {
+    PyObject* world;
+    Py_ssize_t eid;
+    int trigger;
+    PyObject* candidates = Py_None;
+    if (!PyArg_ParseTuple(args, "Oni|O", &world, &eid, &trigger, &candidates)) {
+        return nullptr;
+    }
+
+    Column<int32_t> xs(world, "x", 'i'), ys(world, "y", 'i'), ws(world, "w", 'i'), hs(world, "h", 'i');
+    Column<uint8_t> alive(world, "alive", 'B'), trig(world, "trigger", 'B');
+    if (!xs.ok() || !ys.ok() || !ws.ok() || !hs.ok() || !alive.ok() || !trig.ok()) {
+        return nullptr;
+    }
+    const Py_ssize_t n = xs.size();
+    if (eid < 0 || eid >= n) {
+        PyErr_SetString(PyExc_IndexError, "entity out of range");
+        return nullptr;
+    }
+
+    Rows rows(candidates, n);
+    if (!rows.ok()) {
+        return nullptr;
+    }
+
+    PyObject* out = PyList_New(0);
+    if (out == nullptr) {
+        return nullptr;
+    }
+    const long px = xs[eid], py = ys[eid], pw = ws[eid], ph = hs[eid];
+    for (Py_ssize_t i = 0; i < rows.size(); ++i) {
+        const Py_ssize_t t = rows[i];
+        if (t < 0) {
+            Py_DECREF(out);
+            return nullptr;
+        }
+        if (trig[t] == trigger && alive[t] && t != eid && overlap(px, py, pw, ph, xs[t], ys[t], ws[t], hs[t])) {
+            PyObject* idx = PyLong_FromSsize_t(t);
+            if (idx == nullptr || PyList_Append(out, idx) != 0) {
+                Py_XDECREF(idx);
+                Py_DECREF(out);
+                return nullptr;
+            }
+            Py_DECREF(idx);
+        }
+    }
+    return out;
+}
+
+PyObject* patrol(PyObject*, PyObject* args) {
+    PyObject* world;
+    double t;
+    PyObject* eids = Py_None;
+    if (!PyArg_ParseTuple(args, "Od|O", &world, &t, &eids)) {
+        return nullptr;
+    }
+
+    Column<int32_t> xs(world, "x", 'i'), ys(world, "y", 'i'), ws(world, "w", 'i'), hs(world, "h", 'i');
+    Column<int32_t> dxs(world, "patrol", 'i');
+    Column<uint8_t> alive(world, "alive", 'B'), vertical(world, "vertical", 'B');
+    Column<double> home_x(world, "home_x", 'd'), home_y(world, "home_y", 'd'), speed(world, "speed", 'd');
+    if (!xs.ok() || !ys.ok() || !ws.ok() || !hs.ok() || !dxs.ok() || !alive.ok() || !vertical.ok() ||
+        !home_x.ok() || !home_y.ok() || !speed.ok()) {
+        return nullptr;
+    }
+
+    Rows rows(eids, xs.size());
+    if (!rows.ok()) {
+        return nullptr;
+    }
+    for (Py_ssize_t i = 0; i < rows.size(); ++i) {
+        const Py_ssize_t e = rows[i];
+        if (e < 0) {
+            return nullptr;
+        }
+        if (!alive[e] || !(speed[e] > 0)) {
+            continue;
+        }
+        const double dx = dxs[e];
+        double offset = 0.0;
+        if (dx > 0) {
+            const double lap = 4 * dx;
+            const double s = py_mod(speed[e] * t, lap);
+            if (s < dx) {
+                offset = s;
+            } else if (s < 3 * dx) {
+                offset = 2 * dx - s;
+            } else {
+                offset = s - lap;
+            }
+        }
+        if (vertical[e]) {
+            ys[e] = static_cast<int32_t>(py_round(home_y[e] + offset) - hs[e] / 2);
+        } else {
+            xs[e] = static_cast<int32_t>(py_round(home_x[e] + offset) - ws[e] / 2);
+        }
+    }
+    Py_RETURN_NONE;
+}
+
+PyMethodDef methods[] = {
+    {"move_axis", move_axis, METH_VARARGS, "move_axis(world, eid, axis, amount, rows=None): resolve one row against solid rows."},
+    {"overlaps", overlaps, METH_VARARGS, "overlaps(world, eid, trigger, rows=None) -> list of overlapping trigger rows."},
+    {"patrol", patrol, METH_VARARGS, "patrol(world, t, eids=None): closed-form patrol position for the given (default: every) live row."},
+    {nullptr, nullptr, 0, nullptr},
+};
+
+PyModuleDef module = {
+    PyModuleDef_HEAD_INIT,
+    "_kernel",
+    "Native collision and movement kernels for sprites_collisions.ecs.",
+    -1,
+    methods,
+};
+
+}  // namespace
+
+PyMODINIT_FUNC PyInit__kernel(void) { return PyModule_Create(&module); }
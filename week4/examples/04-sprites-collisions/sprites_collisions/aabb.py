@@ -0,0 +1,110 @@
+"""Batched AABB overlap: one query box against packed min/max coordinate arrays."""
+
+from __future__ import annotations
+
+from typing import Generic, Hashable, Sequence, TypeVar
+
+import numpy as np
+import pygame
+
+T = TypeVar("T", bound=Hashable)
+
+_EMPTY = (np.iinfo(np.int32).max, np.iinfo(np.int32).max, np.iinfo(np.int32).min, np.iinfo(np.int32).min)
+
+
+class BoxSet(Generic[T]):
+    """Items with axis-aligned boxes stored as four packed int32 rows (x0, y0, x1, y1).
+
+    `mask(rect)` tests the query against every box with a few vectorized numpy
+    compares and returns a bool mask over the slots; `hits(rect)` maps it back
+    to items. The rule is Rect.colliderect's: boxes that only share an edge do
+    not overlap.
+
+    Slots keep insertion order, so hits come back in the order spritecollide
+    gives for a group filled the same way. Removed slots are emptied in place
+    and compacted away in bulk.
+    """
+
+    def __init__(self, capacity: int = 64) -> None:
+        self._box = np.empty((4, capacity), np.int32)
+        # Mask and temporary for mask(); reused so a query allocates nothing
+        self._scratch = np.empty((2, capacity), np.bool_)
+        # mask()'s views of the live slots, rebuilt only when the slot count or arrays change
+        self._views: tuple[np.ndarray, ...] | None = None
+        self._items: list[T | None] = []
+        self._slot: dict[T, int] = {}
+        self._dead = 0
+
+    def __len__(self) -> int:
+        return len(self._slot)
+
+    def __contains__(self, item: T) -> bool:
+        return item in self._slot
+
+    def _grow(self) -> None:
+        cap = self._box.shape[1] * 2
+        box = np.empty((4, cap), np.int32)
+        box[:, : len(self._items)] = self._box[:, : len(self._items)]
+        self._box = box
+        self._scratch = np.empty((2, cap), np.bool_)
+        self._views = None
+
+    def add(self, item: T, rect: pygame.Rect) -> None:
+        if len(self._items) == self._box.shape[1]:
+            self._grow()
+        slot = len(self._items)
+        self._items.append(item)
+        self._views = None
+        self._slot[item] = slot
+        self._box[:, slot] = (rect.left, rect.top, rect.right, rect.bottom)
+
+    def move(self, item: T, rect: pygame.Rect) -> None:
+        self._box[:, self._slot[item]] = (rect.left, rect.top, rect.right, rect.bottom)
+
+    def remove(self, item: T) -> None:
+        slot = self._slot.pop(item, None)
+        if slot is None:
+            return
+        self._items[slot] = None
+        self._box[:, slot] = _EMPTY
+        self._dead += 1
+        if self._dead > 32 and 2 * self._dead > len(self._items):
+            self._compact()
+
+    def _compact(self) -> None:
+        keep = [i for i, item in enumerate(self._items) if item is not None]
+        n = len(keep)
+        self._box[:, :n] = self._box[:, keep]
+        self._items = [self._items[i] for i in keep]
+        self._slot = {item: i for i, item in enumerate(self._items)}
+        self._dead = 0
+        self._views = None
+
+    def clear(self) -> None:
+        self._items.clear()
+        self._slot.clear()
+        self._dead = 0
+        self._views = None
+
+    def mask(self, rect: pygame.Rect) -> np.ndarray:
+        """Bool mask over the slots of boxes overlapping rect; valid until the next call."""
+        if self._views is None:
+            n = len(self._items)
+            self._views = (*self._box[:, :n], self._scratch[0, :n], self._scratch[1, :n])
+        x0, y0, x1, y1, m, tmp = self._views
+        np.less(x0, rect.right, out=m)
+        np.greater(x1, rect.left, out=tmp)
+        m &= tmp
+        np.less(y0, rect.bottom, out=tmp)
+        m &= tmp
+        np.greater(y1, rect.top, out=tmp)
+        m &= tmp
+        return m
+
+    def hits(self, rect: pygame.Rect) -> Sequence[T]:
+        m = self.mask(rect)
+        if not m.any():
+            # The usual answer; skips the index array and the list
+            return ()
+        items = self._items
+        return [items[i] for i in np.flatnonzero(m).tolist()]
@@ -0,0 +1,107 @@
+"""Activity regions: only hazards near the player or on screen get per-frame updates."""
+
+from __future__ import annotations
+
+from typing import TYPE_CHECKING, Iterable
+
+import pygame
+
+from . import ecs
+
+if TYPE_CHECKING:
+    from .game import Hazard
+
+
+class ActivityRegions:
+    """Splits hazards into active and idle sets around a focus rect.
+
+    Hazard motion is closed-form, so nothing is integrated here: every hazard
+    shares the level clock and is simply seeked to it. Active hazards are
+    seeked every frame. Idle ones are seeked in round-robin buckets every
+    `idle_every` frames, or never if `idle_every` is 0 (frozen until they wake
+    up, when the seek catches them up exactly).
+
+    A hazard is active when its whole patrol envelope comes within `radius` of
+    the focus or touches the viewport. Classification only runs every
+    `reclassify_every` frames, so `radius` must cover how far the player can
+    travel in that time; anything that could touch the player is then always
+    active and collisions near the player stay exact.
+
+    Given the level's ecs.World, each set is moved by one ecs.patrol call (the
+    native kernel when built) straight on the columns, instead of a seek() per
+    hazard. Hazard.t and direction then stay as of the hazard's last seek().
+    """
+
+    def __init__(self, *, radius: int = 320, idle_every: int = 8, reclassify_every: int = 10) -> None:
+        self.radius = radius
+        self.idle_every = idle_every
+        self.reclassify_every = reclassify_every
+
+        self.clock = 0.0
+        self.active: list[Hazard] = []
+        self.idle: list[Hazard] = []
+        # Entity rows of the two sets, for the batched ECS patrol
+        self._active_eids: list[int] = []
+        self._idle_eids: list[int] = []
+        self._frame = 0
+        self._dirty = True
+
+    def reset(self, clock: float = 0.0) -> None:
+        self.clock = clock
+        self.active = []
+        self.idle = []
+        self._active_eids = []
+        self._idle_eids = []
+        self._dirty = True
+
+    def invalidate(self) -> None:
+        """Force a reclassify on the next update (hazards were added or removed)."""
+        self._dirty = True
+
+    def _classify(
+        self, hazards: Iterable[Hazard], focus: pygame.Rect, viewport: pygame.Rect, world: ecs.World | None
+    ) -> None:
+        near = focus.inflate(2 * self.radius, 2 * self.radius)
+        active: list[Hazard] = []
+        idle: list[Hazard] = []
+        for hz in hazards:
+            env = hz.envelope()
+            if near.colliderect(env) or viewport.colliderect(env):
+                active.append(hz)
+            else:
+                idle.append(hz)
+        # Waking hazards are seeked below along with the rest of the active set
+        self.active = active
+        self.idle = idle
+        if world is not None:
+            self._active_eids = [hz.entity for hz in active]
+            self._idle_eids = [hz.entity for hz in idle]
+        self._dirty = False
+
+    def update(
+        self,
+        hazards: Iterable[Hazard],
+        dt: float,
+        *,
+        focus: pygame.Rect,
+        viewport: pygame.Rect,
+        world: ecs.World | None = None,
+    ) -> None:
+        self.clock += dt
+        self._frame += 1
+        if self._dirty or self._frame % self.reclassify_every == 0:
+            self._classify(hazards, focus, viewport, world)
+
+        clock = self.clock
+        if world is not None:
+            ecs.patrol(world, clock, self._active_eids)
+            if self.idle_every > 0 and self._idle_eids:
+                ecs.patrol(world, clock, self._idle_eids[self._frame % self.idle_every :: self.idle_every])
+            return
+
+        for hz in self.active:
+            hz.seek(clock)
+
+        if self.idle_every > 0 and self.idle:
+            for hz in self.idle[self._frame % self.idle_every :: self.idle_every]:
+                hz.seek(clock)
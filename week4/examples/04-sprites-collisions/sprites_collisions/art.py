@@ -0,0 +1,115 @@
+"""Sprite art: each look is drawn once into an image and blitted from then on.
+
+A look is a small hashable description of what a sprite shows, in logical
+pixels:
+
+    ("circle", radius, color)       anchored at its centre
+    ("triangle", w, h, color)       hazard; anchored at the hitbox's top-left
+    ("rect", w, h, color)           outlined box; anchored at its top-left
+    ("block", w, h, color)          flat box (walls); anchored at its top-left
+
+Colors are RGBA tuples so looks can be dict keys. Sprites report theirs
+through `art` (see game.py), and the frame's sprites then go to the screen
+in one Surface.blits call instead of a few draw calls each.
+"""
+
+from __future__ import annotations
+
+import pygame
+
+CIRCLE, TRIANGLE, RECT, BLOCK = "circle", "triangle", "rect", "block"
+
+Look = tuple
+
+_BLACK = (0, 0, 0, 255)
+
+
+class ArtCache:
+    """Images for looks at one render scale, drawn with the same pygame.draw calls as direct drawing.
+
+    `place()` maps a look at a logical screen position to its image and the
+    internal-pixel position to blit it at. Positions and sizes are scaled edge
+    by edge like Canvas.rect, so a look's image can differ by a pixel with its
+    position at fractional scales; each variant is cached separately.
+    """
+
+    def __init__(self, *, scale: float = 1.0, limit: int = 512) -> None:
+        self.limit = limit
+        self._images: dict[tuple, tuple[pygame.Surface, int, int]] = {}
+        self.set_scale(scale)
+
+    def set_scale(self, scale: float) -> None:
+        self.scale = scale
+        self.line = max(1, round(2 * scale))
+        self._images.clear()
+
+    def key(self, look: Look, x: int, y: int) -> tuple[tuple, int, int]:
+        """(internal look, internal x, internal y) for a look anchored at logical (x, y)."""
+        kind = look[0]
+        k = self.scale
+        if kind == CIRCLE:
+            if k == 1:
+                return look, x, y
+            return (CIRCLE, round(look[1] * k), look[2]), round(x * k), round(y * k)
+
+        _, w, h, color = look
+        if k == 1:
+            if kind == TRIANGLE:
+                return (TRIANGLE, w, h, w // 2, color), x, y
+            return look, x, y
+        x0, y0 = round(x * k), round(y * k)
+        sw, sh = round((x + w) * k) - x0, round((y + h) * k) - y0
+        if kind == TRIANGLE:
+            # Apex rounds on its own, exactly where a directly drawn polygon would put it
+            return (TRIANGLE, sw, sh, round((x + w // 2) * k) - x0, color), x0, y0
+        return (kind, sw, sh, color), x0, y0
+
+    def image(self, key: tuple, outline: bool = True) -> tuple[pygame.Surface, int, int]:
+        """(image, dx, dy) for an internal look; blit it at the anchor plus (dx, dy)."""
+        cached = self._images.get((key, outline))
+        if cached is None:
+            if len(self._images) >= self.limit:
+                self._images.clear()
+            cached = self._images[(key, outline)] = self._draw(key, outline)
+        return cached
+
+    def place(self, look: Look, x: int, y: int, outline: bool = True) -> tuple[pygame.Surface, tuple[int, int]]:
+        """Blit item (image, position) for a look anchored at logical screen position (x, y)."""
+        key, px, py = self.key(look, x, y)
+        image, dx, dy = self.image(key, outline)
+        return image, (px + dx, py + dy)
+
+    def _draw(self, key: tuple, outline: bool) -> tuple[pygame.Surface, int, int]:
+        kind = key[0]
+        line = self.line if outline else 0
+        if kind == CIRCLE:
+            _, radius, color = key
+            size = 2 * radius + 2
+            surf = pygame.Surface((size, size), pygame.SRCALPHA)
+            center = (radius + 1, radius + 1)
+            pygame.draw.circle(surf, color, center, radius)
+            if line:
+                pygame.draw.circle(surf, _BLACK, center, radius, line)
+            return surf, -(radius + 1), -(radius + 1)
+
+        if kind == TRIANGLE:
+            # The polygon and its outline spill past the hitbox, so pad the image
+            _, w, h, apex, color = key
+            pad = self.line
+            surf = pygame.Surface((w + 2 * pad, h + 2 * pad), pygame.SRCALPHA)
+            pts = [(apex + pad, pad), (w + pad, h + pad), (pad, h + pad)]
+            pygame.draw.polygon(surf, color, pts)
+            if line:
+                pygame.draw.polygon(surf, _BLACK, pts, line)
+            return surf, -pad, -pad
+
+        _, w, h, color = key
+        surf = pygame.Surface((w, h), pygame.SRCALPHA)
+        pygame.draw.rect(surf, color, (0, 0, w, h))
+        if line and kind == RECT:
+            pygame.draw.rect(surf, _BLACK, (0, 0, w, h), line)
+        return surf, 0, 0
+
+
+# Scale-1 images for Sprite.image
+SPRITES = ArtCache()
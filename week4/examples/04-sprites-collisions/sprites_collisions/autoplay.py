@@ -0,0 +1,303 @@
+"""Autoplay controller: A* over a navigation grid so the game can run unattended."""
+
+from __future__ import annotations
+
+import heapq
+import math
+import random
+from array import array
+from typing import TYPE_CHECKING, Iterable
+
+import pygame
+
+if TYPE_CHECKING:
+    from .game import Game, Hazard
+
+
+_SQRT2 = math.sqrt(2.0)
+_NEIGHBOURS = (
+    (1, 0, 1.0),
+    (-1, 0, 1.0),
+    (0, 1, 1.0),
+    (0, -1, 1.0),
+    (1, 1, _SQRT2),
+    (1, -1, _SQRT2),
+    (-1, 1, _SQRT2),
+    (-1, -1, _SQRT2),
+)
+
+
+class NavGrid:
+    """Uniform grid over the level, built once per level from the wall rects.
+
+    A cell is blocked when a player hitbox centred on it would overlap a wall.
+    Cells inside a hazard patrol envelope stay walkable but cost extra, so
+    routes only go through hazard lanes when there is no other way.
+    """
+
+    def __init__(
+        self,
+        bounds: pygame.Rect,
+        walls: Iterable[pygame.Rect],
+        *,
+        cell: int = 16,
+        agent_size: int = 28,
+    ) -> None:
+        self.bounds = bounds.copy()
+        self.cell = cell
+        self.cols = max(1, bounds.width // cell)
+        self.rows = max(1, bounds.height // cell)
+        self.blocked = bytearray(self.cols * self.rows)
+        # Flat float32 buffer, not a list: big worlds have millions of cells and rebuild per layout
+        self.cost = array("f", [1.0]) * (self.cols * self.rows)
+        self._agent_size = agent_size
+
+        # +2 keeps a pixel of slack so the rounding in _move_player_axis never scrapes
+        for wall in walls:
+            self._mark(wall.inflate(agent_size + 2, agent_size + 2), blocked=True)
+
+    def _cells_in(self, rect: pygame.Rect) -> Iterable[int]:
+        c = self.cell
+        c0 = max(0, (rect.left - self.bounds.left) // c)
+        c1 = min(self.cols - 1, (rect.right - self.bounds.left) // c)
+        r0 = max(0, (rect.top - self.bounds.top) // c)
+        r1 = min(self.rows - 1, (rect.bottom - self.bounds.top) // c)
+        for row in range(r0, r1 + 1):
+            cy = self.bounds.top + row * c + c // 2
+            if not rect.top <= cy < rect.bottom:
+                continue
+            for col in range(c0, c1 + 1):
+                cx = self.bounds.left + col * c + c // 2
+                if rect.left <= cx < rect.right:
+                    yield row * self.cols + col
+
+    def _mark(self, rect: pygame.Rect, *, blocked: bool = False, penalty: float = 0.0) -> None:
+        for i in self._cells_in(rect):
+            if blocked:
+                self.blocked[i] = 1
+            else:
+                self.cost[i] += penalty
+
+    def add_hazard(self, hazard: Hazard, *, penalty: float = 12.0, margin: int = 10) -> None:
+        env = hazard.envelope().inflate(self._agent_size + margin, self._agent_size + margin)
+        self._mark(env, penalty=penalty)
+
+    def cell_of(self, pos: tuple[float, float]) -> int:
+        col = int((pos[0] - self.bounds.left) // self.cell)
+        row = int((pos[1] - self.bounds.top) // self.cell)
+        col = min(self.cols - 1, max(0, col))
+        row = min(self.rows - 1, max(0, row))
+        return row * self.cols + col
+
+    def center_of(self, index: int) -> tuple[int, int]:
+        row, col = divmod(index, self.cols)
+        return (
+            self.bounds.left + col * self.cell + self.cell // 2,
+            self.bounds.top + row * self.cell + self.cell // 2,
+        )
+
+    def nearest_open(self, index: int, *, radius: int = 4) -> int | None:
+        if not self.blocked[index]:
+            return index
+        row, col = divmod(index, self.cols)
+        best: tuple[int, int] | None = None
+        for dr in range(-radius, radius + 1):
+            for dc in range(-radius, radius + 1):
+                r, c = row + dr, col + dc
+                if 0 <= r < self.rows and 0 <= c < self.cols and not self.blocked[r * self.cols + c]:
+                    d = dr * dr + dc * dc
+                    if best is None or d < best[0]:
+                        best = (d, r * self.cols + c)
+        return None if best is None else best[1]
+
+    def find_path(self, start: int, goal: int) -> tuple[list[int], float] | None:
+        """A* with an octile heuristic; diagonal steps may not cut wall corners."""
+        if self.blocked[goal]:
+            return None
+        cols = self.cols
+        gr, gc = divmod(goal, cols)
+
+        def h(i: int) -> float:
+            r, c = divmod(i, cols)
+            dr, dc = abs(r - gr), abs(c - gc)
+            return (dr + dc) + (_SQRT2 - 2.0) * min(dr, dc)
+
+        g = {start: 0.0}
+        came: dict[int, int] = {}
+        frontier = [(h(start), start)]
+        closed: set[int] = set()
+        while frontier:
+            _, cur = heapq.heappop(frontier)
+            if cur == goal:
+                path = [cur]
+                while cur in came:
+                    cur = came[cur]
+                    path.append(cur)
+                path.reverse()
+                return path, g[goal]
+            if cur in closed:
+                continue
+            closed.add(cur)
+            r, c = divmod(cur, cols)
+            for dc, dr, step in _NEIGHBOURS:
+                nr, nc = r + dr, c + dc
+                if not (0 <= nr < self.rows and 0 <= nc < cols):
+                    continue
+                n = nr * cols + nc
+                if self.blocked[n]:
+                    continue
+                if dr and dc and (self.blocked[r * cols + nc] or self.blocked[nr * cols + c]):
+                    continue
+                cost = g[cur] + step * self.cost[n]
+                if cost < g.get(n, math.inf):
+                    g[n] = cost
+                    came[n] = cur
+                    heapq.heappush(frontier, (cost + h(n), n))
+        return None
+
+
+class AutoPilot:
+    """Drop-in replacement for Game._read_move that plays the level by itself.
+
+    Coins are visited greedily by A* path cost, then the bot heads to the goal
+    once it unlocks. Hazards are avoided twice: their patrol lanes are expensive
+    in the grid, and the bot holds position if a hazard is about to cross its
+    next step.
+    """
+
+    def __init__(self, *, cell: int = 16, candidates: int = 4, seed: int = 0) -> None:
+        self.cell = cell
+        self.candidates = candidates
+        self._rng = random.Random(seed)
+
+        self.grid: NavGrid | None = None
+        self._player = None
+        self._layout = -1
+        self._exploring = False
+        self._target: pygame.sprite.Sprite | None = None
+        self._path: list[tuple[int, int]] = []
+        self._waited = 0.0
+        self._stuck_for = 0.0
+        self._last_pos = (0, 0)
+        # _danger_ahead's query result, reused every frame
+        self._near: list[Hazard] = []
+
+        self.replans = 0
+        self.rebuilds = 0
+
+    def _build(self, game: Game) -> None:
+        # Streamed levels only know about resident chunks; no point gridding the rest
+        self.rebuilds += 1
+        bounds = game.world
+        if game.streamer is not None:
+            bounds = game.world.clip(game.streamer.resident_bounds())
+        self.grid = NavGrid(
+            bounds,
+            (w.rect for w in game.walls),
+            cell=self.cell,
+            agent_size=game.player.rect.width,
+        )
+        for hz in game.hazards:
+            self.grid.add_hazard(hz)
+        self._player = game.player
+        self._layout = game.layout_version
+        self._target = None
+        self._path = []
+
+    def _plan(self, game: Game) -> None:
+        if game.layout_version != self._layout:
+            # Chunks came or went since the grid was built. Rebuilding only here, when a
+            # new route is needed anyway, keeps streaming from costing a rebuild per chunk.
+            self._build(game)
+        grid = self.grid
+        assert grid is not None
+        self.replans += 1
+        self._path = []
+        self._target = None
+        self._exploring = False
+
+        start = grid.nearest_open(grid.cell_of(game.player.rect.center))
+        if start is None:
+            return
+
+        if len(game.coins) > 0:
+            pos = pygame.Vector2(game.player.rect.center)
+            options = sorted(game.coins, key=lambda s: pos.distance_squared_to(s.rect.center))
+            options = options[: self.candidates]
+        else:
+            options = [g for g in game.goals if not g.locked]
+
+        best: tuple[float, list[int], pygame.sprite.Sprite] | None = None
+        for sprite in options:
+            goal = grid.nearest_open(grid.cell_of(sprite.rect.center))
+            if goal is None:
+                continue
+            found = grid.find_path(start, goal)
+            if found is not None and (best is None or found[1] < best[0]):
+                best = (found[1], found[0], sprite)
+
+        if best is None:
+            # Nothing reachable is loaded yet (streamed levels): wander until it is
+            self._explore(game, start)
+            return
+        _, cells, self._target = best
+        self._path = [grid.center_of(i) for i in cells[1:]]
+        self._path.append(self._target.rect.center)
+
+    def _explore(self, game: Game, start: int) -> None:
+        grid = self.grid
+        assert grid is not None
+        for _ in range(32):
+            goal = self._rng.randrange(len(grid.blocked))
+            if grid.blocked[goal]:
+                continue
+            found = grid.find_path(start, goal)
+            if found is not None:
+                self._exploring = True
+                self._path = [grid.center_of(i) for i in found[0][1:]]
+                return
+
+    def _danger_ahead(self, game: Game, step: pygame.Vector2) -> bool:
+        probe = game.player.rect.move(step.x * 14, step.y * 14).inflate(12, 12)
+        # Only hazards whose patrol envelope reaches the probe can be in it
+        return any(probe.colliderect(hz.rect) for hz in game.hazard_index.query(probe, self._near))
+
+    def read_move(self, game: Game, dt: float) -> pygame.Vector2:
+        if self.grid is None or game.player is not self._player:
+            self._build(game)
+
+        lost = (self._target is None and not self._exploring) or (self._target is not None and not self._target.alive())
+        # Wandering is waiting for chunks to load; new ones may hold a reachable coin
+        lost = lost or (self._exploring and game.layout_version != self._layout)
+        if lost or not self._path:
+            self._plan(game)
+        if not self._path:
+            return pygame.Vector2(0, 0)
+
+        pos = pygame.Vector2(game.player.rect.center)
+        while len(self._path) > (0 if self._exploring else 1) and pos.distance_squared_to(self._path[0]) < (self.cell * 0.5) ** 2:
+            self._path.pop(0)
+        if not self._path:
+            return pygame.Vector2(0, 0)
+
+        move = pygame.Vector2(self._path[0]) - pos
+        if move.length_squared() < 1:
+            return pygame.Vector2(0, 0)
+        move.normalize_ip()
+
+        if not game.player.is_invincible and self._danger_ahead(game, move) and self._waited < 1.5:
+            self._waited += dt
+            return pygame.Vector2(0, 0)
+        self._waited = 0.0
+
+        # Knockback or a rounding snag can leave us stuck on a wall edge
+        if game.player.rect.center == self._last_pos:
+            self._stuck_for += dt
+            if self._stuck_for > 0.5:
+                self._stuck_for = 0.0
+                self._plan(game)
+        else:
+            self._stuck_for = 0.0
+        self._last_pos = game.player.rect.center
+
+        return move
@@ -0,0 +1,570 @@
+"""Benchmarks. Run from the example folder:
+
+    python3 -m sprites_collisions.bench kernels
+    python3 -m sprites_collisions.bench aabb
+    python3 -m sprites_collisions.bench renderers
+    python3 -m sprites_collisions.bench alloc
+    python3 -m sprites_collisions.bench gc
+    python3 -m sprites_collisions.bench particles
+    python3 -m sprites_collisions.bench gate
+"""
+
+from __future__ import annotations
+
+import argparse
+import functools
+import gc
+import json
+import os
+import platform
+import random
+import time
+import tracemalloc
+from array import array
+from collections import deque
+from pathlib import Path
+from typing import Callable
+
+os.environ.setdefault("SDL_VIDEODRIVER", "dummy")
+os.environ.setdefault("SDL_AUDIODRIVER", "dummy")
+
+import pygame  # noqa: E402
+
+from . import ecs, levels  # noqa: E402
+from .gcpolicy import GcPolicy  # noqa: E402
+from .perf import mean_ci  # noqa: E402
+
+
+def _game(*, cols: int = 4, rows: int = 4, level=None, use_ecs: bool = False, renderer: str = "surface", **options):
+    from .game import Game
+
+    pygame.init()
+    pygame.mixer.init()
+    if level is None:
+        level = functools.partial(levels.tiled, cols=cols, rows=rows)
+    game = Game(level=level, use_ecs=use_ecs, renderer=renderer, **options)
+    game.state = "play"
+    return game
+
+
+def _timed(fn: Callable[[], object], repeat: int) -> float:
+    start = time.perf_counter()
+    for _ in range(repeat):
+        fn()
+    return (time.perf_counter() - start) / repeat
+
+
+def bench_kernels(args: argparse.Namespace) -> int:
+    """Python vs native ECS kernels on the same world; also checks they agree."""
+    game = _game(cols=args.cols, rows=args.rows, use_ecs=True)
+    base = game.entities
+    player = game.player.entity
+    print(f"rows={len(base)} repeat={args.repeat} native={'built' if ecs._kernel else 'missing'}")
+    if ecs._kernel is None:
+        print("build it with: python3 setup.py build_ext --inplace")
+        return 1
+
+    rng = random.Random(args.seed)
+    steps = [(rng.uniform(-9, 9), rng.uniform(-9, 9)) for _ in range(args.repeat)]
+    # A subset of rows, like the active set ActivityRegions hands to patrol
+    some = [e for e in range(len(base)) if base.kind[e] == ecs.HAZARD][::2]
+
+    results = {}
+    # Put back whatever was selected (SPRITES_KERNELS) for anything run after this
+    was_native = ecs.move_axis is not ecs.py_move_axis
+    for name in ("python", "native"):
+        ecs.use_native(name == "native")
+        world = base.copy()
+        it = iter(steps * 2)
+
+        def move() -> None:
+            dx, dy = next(it)
+            ecs.move_axis(world, player, 0, dx)
+            ecs.move_axis(world, player, 1, dy)
+
+        hits: list[list[int]] = []
+
+        def triggers() -> None:
+            for kind in (ecs.PICKUP, ecs.DAMAGE, ecs.REACH):
+                hits.append(ecs.overlaps(world, player, kind))
+
+        clock = iter(range(args.repeat * 3))
+
+        def patrol() -> None:
+            ecs.patrol(world, next(clock) / 60.0)
+
+        def patrol_some() -> None:
+            ecs.patrol(world, next(clock) / 60.0, some)
+
+        timings = {
+            "move_axis x2": _timed(move, args.repeat),
+            "overlaps x3": _timed(triggers, args.repeat),
+            "patrol": _timed(patrol, args.repeat),
+            "patrol (half)": _timed(patrol_some, args.repeat),
+        }
+        results[name] = (timings, world, hits)
+
+    ecs.use_native(was_native)
+    py, native = results["python"], results["native"]
+    print(f"{'system':<14}{'python ms':>12}{'native ms':>12}{'speedup':>10}")
+    for key in py[0]:
+        a, b = py[0][key] * 1000, native[0][key] * 1000
+        print(f"{key:<14}{a:>12.4f}{b:>12.4f}{a / b:>9.1f}x")
+
+    same = py[2] == native[2] and all(
+        getattr(py[1], col) == getattr(native[1], col) for col in ("x", "y", "w", "h")
+    )
+    print("results identical" if same else "MISMATCH between python and native kernels")
+    return 0 if same else 1
+
+
+def bench_aabb(args: argparse.Namespace) -> int:
+    """One query box against N rects: BoxSet.mask vs colliderect and collidelistall."""
+    from .aabb import BoxSet
+
+    rng = random.Random(args.seed)
+    size = int((args.count * 40 * 40) ** 0.5 * 2)
+    rects = [
+        pygame.Rect(rng.randrange(size), rng.randrange(size), rng.randint(8, 40), rng.randint(8, 40))
+        for _ in range(args.count)
+    ]
+    boxes: BoxSet[int] = BoxSet()
+    for i, r in enumerate(rects):
+        boxes.add(i, r)
+    queries = [pygame.Rect(rng.randrange(size), rng.randrange(size), 28, 28) for _ in range(args.repeat)]
+
+    def pairwise() -> None:
+        q = next(it)
+        [i for i, r in enumerate(rects) if r.colliderect(q)]
+
+    it = iter(queries)
+    per_pair = _timed(pairwise, min(args.repeat, 50))
+    it = iter(queries)
+    listall = _timed(lambda: next(it).collidelistall(rects), args.repeat)
+    it = iter(queries)
+    batched = _timed(lambda: boxes.mask(next(it)), args.repeat)
+
+    same = all(list(boxes.hits(q)) == q.collidelistall(rects) for q in queries[:200])
+    print(f"rects={args.count} repeat={args.repeat}")
+    print(f"{'method':<22}{'ms/query':>10}")
+    print(f"{'colliderect loop':<22}{per_pair * 1000:>10.3f}")
+    print(f"{'Rect.collidelistall':<22}{listall * 1000:>10.3f}")
+    print(f"{'BoxSet.mask':<22}{batched * 1000:>10.3f}")
+    print("results identical" if same else "MISMATCH between BoxSet and collidelistall")
+    return 0 if same else 1
+
+
+def bench_renderers(args: argparse.Namespace) -> int:
+    """Per-frame present() cost (render + scale + flip/present) of each backend at each render scale."""
+    from .autoplay import AutoPilot
+
+    window = tuple(int(n) for n in args.window.lower().split("x")) if args.window else None
+    print(f"frames={args.frames} level={args.cols}x{args.rows} window={args.window} video={os.environ['SDL_VIDEODRIVER']}")
+    print(f"{'backend':<10}{'scale':>6}{'avg ms':>10}{'p95 ms':>10}{'max ms':>10}{'uploads':>10}")
+    for name, scale in ((n, s) for n in ("surface", "texture") for s in args.scales):
+        game = _game(cols=args.cols, rows=args.rows, renderer=name, render_scale=scale, window=window)
+        game.autopilot = AutoPilot(seed=args.seed)
+        times = []
+        for i in range(args.warmup + args.frames):
+            game.update(1 / 60)
+            snap = game.snapshot()
+            start = time.perf_counter()
+            game.present(snap)
+            if i >= args.warmup:
+                times.append(time.perf_counter() - start)
+        times.sort()
+        uploads = game.backend.uploads if game.backend is not None else 0
+        avg = sum(times) / len(times) * 1000
+        p95 = times[int(0.95 * len(times))] * 1000
+        print(f"{name:<10}{scale:>6g}{avg:>10.3f}{p95:>10.3f}{times[-1] * 1000:>10.3f}{uploads:>10}")
+        game.tiles.close()
+    return 0
+
+
+class _Circler:
+    """Stands in for the A* bot (which allocates while it plans): walks a slow circle off one vector."""
+
+    def __init__(self) -> None:
+        self.move = pygame.Vector2(1, 0)
+
+    def read_move(self, game, dt: float) -> pygame.Vector2:
+        self.move.rotate_ip(90 * dt)
+        return self.move
+
+
+def bench_alloc(args: argparse.Namespace) -> int:
+    """Memory blocks a steady-state frame (update + snapshot + present) allocates, via tracemalloc.
+
+    tracemalloc sees live blocks, not malloc calls, so two numbers come out:
+    blocks a frame leaves behind (anything above zero piles up for the GC),
+    and the peak of short-lived allocations inside a frame above where it
+    started. Both are checked against budgets; the exit code says if they held.
+    """
+    game = _game(cols=args.cols, rows=args.rows, use_ecs=args.ecs, renderer=args.renderer)
+    game.autopilot = _Circler()
+    # Damage would end the run partway; this is about the frame, not the game
+    game.player.hp = 1 << 30
+
+    def frame() -> None:
+        game.update(1 / 60)
+        game.present(game.snapshot())
+
+    for _ in range(args.warmup):
+        frame()
+
+    tracemalloc.start(args.depth)
+    # A full collection also empties CPython's freelists, whose parked blocks would count as kept
+    gc.collect()
+    before = tracemalloc.take_snapshot()
+    # Preallocated so recording a frame allocates nothing itself
+    peaks = array("q", bytes(8 * args.frames))
+    for i in range(args.frames):
+        tracemalloc.reset_peak()
+        start = tracemalloc.get_traced_memory()[0]
+        frame()
+        peaks[i] = tracemalloc.get_traced_memory()[1] - start
+    gc.collect()
+    after = tracemalloc.take_snapshot()
+    tracemalloc.stop()
+
+    ignore = (tracemalloc.Filter(False, tracemalloc.__file__),)
+    diff = after.filter_traces(ignore).compare_to(before.filter_traces(ignore), "traceback")
+    kept = sum(d.count_diff for d in diff)
+    per_frame = kept / args.frames
+    peaks = sorted(peaks)
+    p50, worst = peaks[len(peaks) // 2], peaks[-1]
+
+    print(f"frames={args.frames} level={args.cols}x{args.rows} ecs={args.ecs} renderer={args.renderer}")
+    print(f"{'blocks kept/frame':<22}{per_frame:>10.2f}  (budget {args.max_blocks:g})")
+    print(f"{'transient p50 bytes':<22}{p50:>10}")
+    print(f"{'transient max bytes':<22}{worst:>10}  (budget {args.max_bytes})")
+    for d in sorted(diff, key=lambda d: -d.count_diff)[: args.top]:
+        if d.count_diff > 0:
+            print(f"  +{d.count_diff} blocks  {d.traceback.format()[-1].strip()}")
+    ok = per_frame <= args.max_blocks and worst <= args.max_bytes
+    print("within budget" if ok else "OVER BUDGET")
+    return 0 if ok else 1
+
+
+def bench_gc(args: argparse.Namespace) -> int:
+    """Frame work time and GC pauses with Python's own collector vs GcPolicy("idle").
+
+    Frames run back to back with the A* bot playing. In idle mode each frame
+    ends with GcPolicy.idle() and a 60 fps deadline, so collections there
+    count as scheduled, not in-frame.
+
+    The game frees almost everything it allocates within the frame, which
+    never trips a collection. So each frame also makes `--churn` small
+    reference cycles, kept for `--keep` frames, standing in for gameplay
+    code that holds on to garbage. Fails if neither mode collected.
+    """
+    from .autoplay import AutoPilot
+
+    print(f"frames={args.frames} level={args.cols}x{args.rows} ecs={args.ecs} churn={args.churn}x{args.keep}")
+    print(
+        f"{'mode':<6}{'work p50':>10}{'p99':>8}{'max':>8}{'GCs':>7}"
+        f"{'in-frame':>10}{'max ms':>8}{'scheduled':>11}{'max ms':>8}"
+    )
+    counts = []
+    for mode in ("auto", "idle"):
+        policy = GcPolicy(mode)
+        game = _game(cols=args.cols, rows=args.rows, use_ecs=args.ecs, gc_policy=policy)
+        game.autopilot = AutoPilot(seed=args.seed)
+        game.player.hp = 1 << 30
+        work = []
+        scheduled_max = 0.0
+        held: deque[list] = deque(maxlen=args.keep)
+        for i in range(args.warmup + args.frames):
+            if i == args.warmup:
+                # Only the measured frames count; the level load is already behind us
+                policy.count = policy.in_frame = 0
+                policy.max_ms = policy.in_frame_max_ms = 0.0
+                work.clear()
+            start = time.perf_counter()
+            garbage = [{"frame": i} for _ in range(args.churn)]
+            for node in garbage:
+                node["self"] = node
+            held.append(garbage)
+            game.update(1 / 60)
+            game.present(game.snapshot())
+            work.append(time.perf_counter() - start)
+            if game.state != "play":
+                game.state = "play"
+            before = policy.count
+            policy.idle(start + 1 / 60)
+            if policy.count > before:
+                scheduled_max = max(scheduled_max, policy.last_ms)
+        work.sort()
+        p50, p99 = work[len(work) // 2] * 1000, work[int(0.99 * len(work))] * 1000
+        scheduled = policy.count - policy.in_frame
+        print(
+            f"{mode:<6}{p50:>10.2f}{p99:>8.2f}{work[-1] * 1000:>8.2f}{policy.count:>7}"
+            f"{policy.in_frame:>10}{policy.in_frame_max_ms:>8.2f}{scheduled:>11}{scheduled_max:>8.2f}"
+        )
+        counts.append(policy.count)
+        policy.close()
+        game.tiles.close()
+    if not any(counts):
+        print("no collections in either mode; raise --churn or --frames to measure anything")
+        return 1
+    return 0
+
+
+def bench_particles(args: argparse.Namespace) -> int:
+    """Frame cost with N particles kept alive around the player, per backend.
+
+    Each frame tops the pool back up to N with bursts at the player, so the
+    timings are for a steady N in view (update includes ParticlePool.update).
+    """
+    from .particles import KINDS, ParticlePool
+
+    print(f"frames={args.frames} level={args.cols}x{args.rows} capacity={args.capacity}")
+    print(f"{'backend':<10}{'alive':>7}{'update ms':>11}{'snapshot':>10}{'present':>9}{'dropped':>9}")
+    for name in args.renderers:
+        for alive in args.counts:
+            game = _game(cols=args.cols, rows=args.rows, renderer=name)
+            game.autopilot = _Circler()
+            game.player.hp = 1 << 30
+            game.particles = pool = ParticlePool(args.capacity, seed=args.seed)
+            times = {"update": [], "snapshot": [], "present": []}
+            for i in range(args.warmup + args.frames):
+                kind = i % len(KINDS)
+                while pool.count < alive:
+                    pool.emit(kind, game.player.rect.center, min(64, alive - pool.count))
+                t0 = time.perf_counter()
+                game.update(1 / 60)
+                t1 = time.perf_counter()
+                snap = game.snapshot()
+                t2 = time.perf_counter()
+                game.present(snap)
+                t3 = time.perf_counter()
+                if i >= args.warmup:
+                    times["update"].append(t1 - t0)
+                    times["snapshot"].append(t2 - t1)
+                    times["present"].append(t3 - t2)
+            ms = {k: sorted(v)[len(v) // 2] * 1000 for k, v in times.items()}
+            print(
+                f"{name:<10}{alive:>7}{ms['update']:>11.3f}"
+                f"{ms['snapshot']:>10.3f}{ms['present']:>9.3f}{pool.dropped:>9}"
+            )
+            game.tiles.close()
+    return 0
+
+
+# Levels the regression gate times; the huge one is seeded, so every run builds the same world
+GATE_LEVELS = {
+    "small": levels.arena,
+    "medium": functools.partial(levels.tiled, cols=4, rows=4),
+    "huge": functools.partial(levels.generated, walls=20000, coins=10000, hazards=5000, seed=1),
+}
+GATE_PHASES = ("update", "draw")
+BASELINE = Path(__file__).resolve().parent.parent / "bench_baseline.json"
+
+
+def _gate_run(level, *, frames: int, warmup: int) -> dict[str, float]:
+    """Median ms per frame of each phase over one fresh game: update, and snapshot + present.
+
+    Medians, so one frame that lost the CPU to the tile worker or a GC pause
+    does not move the result.
+    """
+    game = _game(level=level, seed=0)
+    game.autopilot = _Circler()
+    game.player.hp = 1 << 30
+    times = {phase: array("d", bytes(8 * frames)) for phase in GATE_PHASES}
+    update, draw = times["update"], times["draw"]
+    gc.collect()
+    for i in range(warmup + frames):
+        t0 = time.perf_counter()
+        game.update(1 / 60)
+        t1 = time.perf_counter()
+        game.present(game.snapshot())
+        t2 = time.perf_counter()
+        if i >= warmup:
+            update[i - warmup] = t1 - t0
+            draw[i - warmup] = t2 - t1
+    game.tiles.close()
+    return {phase: sorted(t)[frames // 2] * 1000 for phase, t in times.items()}
+
+
+def _calibrate(repeat: int = 15) -> float:
+    """Median ms of a fixed mix of interpreter, Rect and blit work: how fast this machine is right now."""
+    target = pygame.Surface((320, 240))
+    sprite = pygame.Surface((32, 32))
+    rects = [pygame.Rect(i * 7 % 300, i * 13 % 220, 16, 16) for i in range(400)]
+    samples = []
+    for _ in range(repeat):
+        start = time.perf_counter()
+        probe = pygame.Rect(100, 100, 60, 60)
+        hits = 0
+        for _ in range(10):
+            for r in rects:
+                if probe.colliderect(r):
+                    hits += 1
+                r.move_ip(1, 0)
+                r.move_ip(-1, 0)
+        target.blits([(sprite, r.topleft) for r in rects], doreturn=False)
+        samples.append(time.perf_counter() - start)
+    return sorted(samples)[repeat // 2] * 1000
+
+
+def bench_gate(args: argparse.Namespace) -> int:
+    """Times update and draw on small/medium/huge levels and fails on a regression against the baseline.
+
+    Each scenario runs --runs times on a fresh game, and each phase gets a
+    mean and 95% confidence interval over those runs' per-frame medians. A phase regresses when
+    its mean is more than --threshold over the baseline and the lower end of
+    its interval is still above the upper end of the baseline's, so noise
+    alone does not fail the gate.
+
+    Shared machines speed up and slow down as a whole, so every pass also
+    times a fixed calibration workload, and current numbers are scaled by
+    baseline calibration / current calibration before the comparison.
+    --update writes the results as the new baseline; re-record it on the
+    machine type that runs the gate.
+    """
+    path = Path(args.baseline)
+    baseline = None
+    if not args.update:
+        if not path.exists():
+            print(f"no baseline at {path}; record one with --update")
+            return 2
+        baseline = json.loads(path.read_text())
+        if baseline["machine"] != _machine():
+            print(f"note: baseline recorded on {baseline['machine']}, this is {_machine()}")
+
+    # Round robin, so a slow stretch of the machine hits every scenario instead of one
+    runs: dict[str, list[dict[str, float]]] = {name: [] for name in args.scenarios}
+    calibration = []
+    for _ in range(args.runs):
+        calibration.append(_calibrate())
+        for name in args.scenarios:
+            runs[name].append(_gate_run(GATE_LEVELS[name], frames=args.frames, warmup=args.warmup))
+    calibration.sort()
+    calib_ms = calibration[len(calibration) // 2]
+    results: dict[str, dict[str, list[float]]] = {}
+    for name in args.scenarios:
+        results[name] = {}
+        for phase in GATE_PHASES:
+            mean, ci = mean_ci([r[phase] for r in runs[name]])
+            results[name][phase] = [round(mean, 4), round(ci, 4)]
+
+    if args.update:
+        doc = {
+            "machine": _machine(),
+            "calibration_ms": round(calib_ms, 4),
+            "runs": args.runs,
+            "frames": args.frames,
+            "scenarios": results,
+        }
+        path.write_text(json.dumps(doc, indent=2) + "\n")
+        print(f"baseline written to {path}")
+        return 0
+
+    speed = baseline["calibration_ms"] / calib_ms
+    print(f"runs={args.runs} frames={args.frames} threshold={args.threshold:.0%} video={os.environ['SDL_VIDEODRIVER']}")
+    print(f"calibration {calib_ms:.3f} ms vs {baseline['calibration_ms']:.3f} ms at baseline: current times x {speed:.2f}")
+    print(f"{'scenario':<10}{'phase':<8}{'baseline ms':>16}{'current ms':>16}{'change':>9}  verdict")
+    failed = 0
+    for name, phases in results.items():
+        for phase, (mean, ci) in phases.items():
+            mean, ci = mean * speed, ci * speed
+            base = baseline["scenarios"].get(name, {}).get(phase)
+            if base is None:
+                print(f"{name:<10}{phase:<8}{'-':>16}{mean:>9.3f} ±{ci:<5.3f}{'':>9}  new")
+                continue
+            base_mean, base_ci = base
+            change = mean / base_mean - 1
+            if change > args.threshold and mean - ci > base_mean + base_ci:
+                verdict = "REGRESSED"
+                failed += 1
+            elif change < -args.threshold and mean + ci < base_mean - base_ci:
+                verdict = "faster"
+            else:
+                verdict = "ok"
+            print(f"{name:<10}{phase:<8}{base_mean:>9.3f} ±{base_ci:<5.3f}{mean:>9.3f} ±{ci:<5.3f}{change:>+9.1%}  {verdict}")
+    print(f"{failed} regression(s)" if failed else "no regressions")
+    return 1 if failed else 0
+
+
+def _machine() -> str:
+    return f"{platform.machine()} {platform.python_implementation()} {platform.python_version()} pygame {pygame.version.ver}"
+
+
+def main() -> int:
+    parser = argparse.ArgumentParser(prog="python3 -m sprites_collisions.bench")
+    sub = parser.add_subparsers(dest="scenario", required=True)
+
+    k = sub.add_parser("kernels", help="python vs native ECS kernels")
+    k.add_argument("--cols", type=int, default=8)
+    k.add_argument("--rows", type=int, default=8)
+    k.add_argument("--repeat", type=int, default=2000)
+    k.add_argument("--seed", type=int, default=1)
+    k.set_defaults(run=bench_kernels)
+
+    a = sub.add_parser("aabb", help="batched overlap vs per-pair colliderect")
+    a.add_argument("--count", type=int, default=100_000)
+    a.add_argument("--repeat", type=int, default=500)
+    a.add_argument("--seed", type=int, default=1)
+    a.set_defaults(run=bench_aabb)
+
+    r = sub.add_parser("renderers", help="Surface vs SDL2 Texture backend frame cost")
+    r.add_argument("--cols", type=int, default=4)
+    r.add_argument("--rows", type=int, default=4)
+    r.add_argument("--frames", type=int, default=600)
+    r.add_argument("--warmup", type=int, default=60)
+    r.add_argument("--seed", type=int, default=0)
+    r.add_argument("--scales", type=float, nargs="+", default=[1.0], help="render scales to compare")
+    r.add_argument("--window", default=None, help="WxH window (default: logical size)")
+    r.set_defaults(run=bench_renderers)
+
+    m = sub.add_parser("alloc", help="tracemalloc check of a steady-state frame's allocations")
+    m.add_argument("--cols", type=int, default=4)
+    m.add_argument("--rows", type=int, default=4)
+    m.add_argument("--ecs", action="store_true")
+    m.add_argument("--renderer", choices=("surface", "texture"), default="surface")
+    m.add_argument("--frames", type=int, default=1800)
+    m.add_argument("--warmup", type=int, default=300)
+    m.add_argument("--depth", type=int, default=1, help="traceback frames kept per block")
+    m.add_argument("--top", type=int, default=5, help="show the lines that kept the most blocks")
+    m.add_argument("--max-blocks", type=float, default=0.5, help="budget: blocks kept per frame")
+    m.add_argument("--max-bytes", type=int, default=16384, help="budget: transient peak within a frame")
+    m.set_defaults(run=bench_alloc)
+
+    g = sub.add_parser("gc", help="GC pauses: automatic collection vs frozen levels + idle-time collection")
+    g.add_argument("--cols", type=int, default=6)
+    g.add_argument("--rows", type=int, default=6)
+    g.add_argument("--ecs", action="store_true")
+    g.add_argument("--frames", type=int, default=3600)
+    g.add_argument("--warmup", type=int, default=120)
+    g.add_argument("--churn", type=int, default=100, help="reference cycles made per frame")
+    g.add_argument("--keep", type=int, default=30, help="frames each frame's cycles stay referenced")
+    g.add_argument("--seed", type=int, default=0)
+    g.set_defaults(run=bench_gc)
+
+    p = sub.add_parser("particles", help="frame cost with thousands of particles alive")
+    p.add_argument("--cols", type=int, default=4)
+    p.add_argument("--rows", type=int, default=4)
+    p.add_argument("--counts", type=int, nargs="+", default=[0, 1000, 4000], help="particles kept alive")
+    p.add_argument("--capacity", type=int, default=4096)
+    p.add_argument("--renderers", nargs="+", choices=("surface", "texture"), default=["surface", "texture"])
+    p.add_argument("--frames", type=int, default=300)
+    p.add_argument("--warmup", type=int, default=30)
+    p.add_argument("--seed", type=int, default=0)
+    p.set_defaults(run=bench_particles)
+
+    gt = sub.add_parser("gate", help="update/draw regression check against the committed baseline")
+    gt.add_argument("--scenarios", nargs="+", choices=tuple(GATE_LEVELS), default=list(GATE_LEVELS))
+    gt.add_argument("--runs", type=int, default=5, help="fresh games per scenario (the confidence interval is over these)")
+    gt.add_argument("--frames", type=int, default=300)
+    gt.add_argument("--warmup", type=int, default=60)
+    gt.add_argument("--threshold", type=float, default=0.15, help="slowdown that counts as a regression (0.15 = 15%%)")
+    gt.add_argument("--baseline", default=str(BASELINE))
+    gt.add_argument("--update", action="store_true", help="record this run as the new baseline")
+    gt.set_defaults(run=bench_gate)
+
+    args = parser.parse_args()
+    return args.run(args)
+
+
+if __name__ == "__main__":
+    raise SystemExit(main())
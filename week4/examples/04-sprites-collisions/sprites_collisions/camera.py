@@ -0,0 +1,53 @@
+"""Follow camera for worlds larger than the playfield."""
+
+from __future__ import annotations
+
+import math
+
+import pygame
+
+
+class Camera:
+    """A viewport-sized window onto the world, kept in world coordinates.
+
+    `viewport` is where the view lands on screen; `offset` converts world
+    positions to screen positions. If the world is smaller than the viewport
+    on an axis the view is centred on it, so a one-screen level never scrolls.
+    """
+
+    def __init__(self, viewport: pygame.Rect, world: pygame.Rect, *, stiffness: float = 8.0) -> None:
+        self.viewport = viewport.copy()
+        self.world = world.copy()
+        self.stiffness = stiffness
+        self.view = pygame.Rect(viewport.topleft, viewport.size)
+        self._x = float(self.view.x)
+        self._y = float(self.view.y)
+        self.snap(world.center)
+
+    def _target(self, center: tuple[float, float]) -> tuple[float, float]:
+        w, h = self.view.size
+        world = self.world
+        if world.width <= w:
+            x = world.centerx - w / 2
+        else:
+            x = min(max(center[0] - w / 2, world.left), world.right - w)
+        if world.height <= h:
+            y = world.centery - h / 2
+        else:
+            y = min(max(center[1] - h / 2, world.top), world.bottom - h)
+        return x, y
+
+    def snap(self, center: tuple[float, float]) -> None:
+        self._x, self._y = self._target(center)
+        self.view.topleft = (round(self._x), round(self._y))
+
+    def follow(self, center: tuple[float, float], dt: float) -> None:
+        tx, ty = self._target(center)
+        k = 1.0 - math.exp(-self.stiffness * dt)
+        self._x += (tx - self._x) * k
+        self._y += (ty - self._y) * k
+        self.view.topleft = (round(self._x), round(self._y))
+
+    @property
+    def offset(self) -> tuple[int, int]:
+        return self.viewport.x - self.view.x, self.viewport.y - self.view.y
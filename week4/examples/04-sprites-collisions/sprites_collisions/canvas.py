@@ -0,0 +1,86 @@
+"""Internal render resolution, independent of the window size."""
+
+from __future__ import annotations
+
+import pygame
+
+
+class Canvas:
+    """The internal render target and its mapping from logical coordinates.
+
+    Game logic and snapshots work in logical pixels (Game.SCREEN_W x
+    SCREEN_H). Drawing lands on `surface` at `scale` internal pixels per
+    logical pixel, and present() stretches that to the window once per frame,
+    letterboxed to keep the aspect ratio. A scale below the window's own
+    trades sharpness for fill cost; a scale matching it renders at native
+    resolution. When the internal size equals the window, the canvas is the
+    display surface itself and presenting is just a flip.
+
+    Logical -> internal is round(v * scale), applied to edges rather than
+    sizes, so neighbouring rects and tiles never open seams.
+    """
+
+    def __init__(
+        self,
+        logical: tuple[int, int],
+        *,
+        scale: float = 1.0,
+        window: tuple[int, int] | None = None,
+        smooth: bool = False,
+        display: bool = True,
+    ) -> None:
+        self.logical = logical
+        self.window = window or logical
+        # Upscale filter: smoothscale (bilinear) or nearest-neighbour
+        self.smooth = smooth
+        # No display with the texture backend, which owns its own window
+        self.display = pygame.display.set_mode(self.window) if display else None
+        self.set_scale(scale)
+
+    def set_scale(self, scale: float) -> None:
+        self.scale = scale
+        lw, lh = self.logical
+        self.size = (max(1, round(lw * scale)), max(1, round(lh * scale)))
+
+        ww, wh = self.window
+        fit = min(ww / lw, wh / lh)
+        self.dest = pygame.Rect(0, 0, round(lw * fit), round(lh * fit))
+        self.dest.center = (ww // 2, wh // 2)
+
+        if self.display is not None and self.size == self.window:
+            self.surface = self.display
+            return
+        self.surface = pygame.Surface(self.size, 0, self.display) if self.display else pygame.Surface(self.size)
+        if self.display is not None:
+            self.display.fill((0, 0, 0))
+            self._target = self.display.subsurface(self.dest)
+
+    # Logical -> internal pixels
+
+    def px(self, v: float) -> int:
+        return round(v * self.scale)
+
+    def width(self, w: int) -> int:
+        """Line width; never thinner than one pixel."""
+        return max(1, round(w * self.scale))
+
+    def point(self, p: tuple[float, float]) -> tuple[int, int]:
+        k = self.scale
+        return round(p[0] * k), round(p[1] * k)
+
+    def rect(self, r: pygame.Rect | tuple[int, int, int, int]) -> pygame.Rect:
+        x, y, w, h = r
+        k = self.scale
+        if k == 1:
+            return pygame.Rect(x, y, w, h)
+        x0, y0 = round(x * k), round(y * k)
+        return pygame.Rect(x0, y0, round((x + w) * k) - x0, round((y + h) * k) - y0)
+
+    def present(self) -> None:
+        """Show the surface backend's frame: one scale pass if needed, then flip."""
+        if self.surface is not self.display:
+            if self.smooth:
+                pygame.transform.smoothscale(self.surface, self.dest.size, self._target)
+            else:
+                pygame.transform.scale(self.surface, self.dest.size, self._target)
+        pygame.display.flip()
@@ -0,0 +1,200 @@
+"""Frame capture for QA: screenshots and recordings written off the frame.
+
+The frame only pays for one blit (or a texture read-back) into a pooled
+surface. Encoding and disk I/O happen on a writer thread.
+"""
+
+from __future__ import annotations
+
+import logging
+import queue
+import shutil
+import struct
+import subprocess
+import sys
+import threading
+import time
+import zlib
+from pathlib import Path
+from typing import Callable
+
+import numpy as np
+import pygame
+
+log = logging.getLogger(__name__)
+
+
+def write_png(surface: pygame.Surface, path: str | Path, *, level: int = 3) -> None:
+    """Encode an RGB PNG with zlib.
+
+    pygame.image.save holds the GIL for the whole encode (~20 ms for a
+    960x540 frame), which stalls the game even from another thread.
+    zlib.compress and file writes release it. The rows are built straight
+    from the surface's pixels with numpy, so the GIL-held part is about
+    0.6 ms.
+    """
+    w, h = surface.get_size()
+    # Filter byte 0 (none) in front of every row
+    rows = np.zeros((h, 3 * w + 1), np.uint8)
+    rgb = rows[:, 1:].reshape(h, w, 3)
+    if surface.get_bytesize() == 4 and sys.byteorder == "little":
+        px = np.frombuffer(surface.get_view("0"), np.uint8)
+        px = px.reshape(h, surface.get_pitch())[:, : 4 * w].reshape(h, w, 4)
+        for i, shift in enumerate(surface.get_shifts()[:3]):
+            rgb[..., i] = px[..., shift // 8]
+        del px  # releases the surface lock
+    else:
+        rgb[...] = np.frombuffer(pygame.image.tobytes(surface, "RGB"), np.uint8).reshape(h, w, 3)
+
+    def chunk(tag: bytes, data: bytes) -> bytes:
+        return struct.pack(">I", len(data)) + tag + data + struct.pack(">I", zlib.crc32(tag + data))
+
+    with open(path, "wb") as f:
+        f.write(b"\x89PNG\r\n\x1a\n")
+        f.write(chunk(b"IHDR", struct.pack(">IIBBBBB", w, h, 8, 2, 0, 0, 0)))
+        f.write(chunk(b"IDAT", zlib.compress(rows, level)))
+        f.write(chunk(b"IEND", b""))
+
+
+class FrameCapture:
+    """Copies frames into a fixed pool of surfaces; a writer thread saves them.
+
+    `grab(fill)` takes a free pooled surface and calls fill(surface) to copy
+    the frame into it. If every surface is still queued or being written,
+    the frame is dropped and counted, and the game loop never waits.
+
+    While `recording`, every `every`-th frame goes out. With an encoder
+    available (ffmpeg on PATH), raw RGB frames are piped to it and it writes
+    `capture.mp4`. Otherwise each frame becomes a numbered PNG. `screenshot()`
+    saves the next frame as its own PNG either way.
+    """
+
+    def __init__(
+        self,
+        out_dir: str | Path,
+        size: tuple[int, int],
+        *,
+        recording: bool = False,
+        every: int = 1,
+        pool: int = 8,
+        fps: int = 60,
+        encoder: str | None = "ffmpeg",
+    ) -> None:
+        self.out_dir = Path(out_dir)
+        self.out_dir.mkdir(parents=True, exist_ok=True)
+        self.size = size
+        self.recording = recording
+        self.every = max(1, every)
+        self.fps = fps
+
+        self.frames = 0
+        self.captured = 0
+        self.written = 0
+        self.dropped = 0
+
+        self._free: queue.SimpleQueue[pygame.Surface] = queue.SimpleQueue()
+        for _ in range(pool):
+            self._free.put(pygame.Surface(size))
+        # Never holds more than the pool, so put() below cannot block
+        self._ready: queue.Queue[tuple[pygame.Surface, str] | None] = queue.Queue(maxsize=pool + 1)
+        self._shot_pending = False
+        self._encoder: subprocess.Popen | None = None
+        self._encoder_path = shutil.which(encoder) if encoder else None
+        if recording and self._encoder_path is None:
+            log.info("capture: no %s on PATH, recording PNG frames to %s", encoder, self.out_dir)
+        self._writer = threading.Thread(target=self._write_loop, name="CaptureWriter", daemon=True)
+        self._writer.start()
+
+    def screenshot(self) -> None:
+        """Save the next grabbed frame as a PNG."""
+        self._shot_pending = True
+
+    def grab(self, fill: Callable[[pygame.Surface], None]) -> None:
+        """Called once per presented frame; copies it out if anything wants it."""
+        self.frames += 1
+        record = self.recording and self.frames % self.every == 0
+        if not (record or self._shot_pending):
+            return
+        try:
+            surf = self._free.get_nowait()
+        except queue.Empty:
+            self.dropped += 1
+            return
+        fill(surf)
+        self.captured += 1
+        if self._shot_pending:
+            self._shot_pending = False
+            kind = "shot"
+        else:
+            kind = "frame"
+        self._ready.put_nowait((surf, kind))
+
+    def _write_loop(self) -> None:
+        while True:
+            item = self._ready.get()
+            if item is None:
+                break
+            surf, kind = item
+            try:
+                self._write(surf, kind)
+                self.written += 1
+            except Exception:
+                log.exception("capture: writing a %s failed", kind)
+            finally:
+                self._free.put(surf)
+        self._stop_encoder()
+
+    def _write(self, surf: pygame.Surface, kind: str) -> None:
+        if kind == "shot":
+            path = self.out_dir / f"shot-{time.strftime('%Y%m%d-%H%M%S')}-{self.written:06d}.png"
+            write_png(surf, path)
+            log.info("capture: screenshot %s", path)
+            return
+        if self._encoder_path is None:
+            write_png(surf, self.out_dir / f"frame-{self.written:06d}.png", level=1)
+            return
+        if self._encoder is None:
+            self._encoder = self._start_encoder()
+        try:
+            self._encoder.stdin.write(pygame.image.tobytes(surf, "RGB"))
+        except BrokenPipeError:
+            log.error("capture: encoder exited (status %s); recording PNG frames instead", self._stop_encoder())
+            self._encoder_path = None
+
+    def _stop_encoder(self) -> int | None:
+        """Close the encoder's input and reap it; returns its exit status."""
+        encoder, self._encoder = self._encoder, None
+        if encoder is None:
+            return None
+        try:
+            encoder.stdin.close()
+        except BrokenPipeError:
+            # It already exited with frames still buffered for it
+            pass
+        return encoder.wait()
+
+    def _start_encoder(self) -> subprocess.Popen:
+        w, h = self.size
+        path = self.out_dir / "capture.mp4"
+        log.info("capture: encoding to %s", path)
+        return subprocess.Popen(
+            [
+                self._encoder_path, "-loglevel", "error", "-y",
+                "-f", "rawvideo", "-pix_fmt", "rgb24", "-s", f"{w}x{h}", "-r", str(self.fps / self.every),
+                "-i", "-",
+                "-c:v", "libx264", "-preset", "ultrafast", "-pix_fmt", "yuv420p", str(path),
+            ],
+            stdin=subprocess.PIPE,
+        )
+
+    def close(self) -> None:
+        """Finish what is queued, stop the writer, and log the totals."""
+        self._ready.put(None)
+        self._writer.join()
+        log.info(
+            "capture: %d frames captured, %d written, %d dropped (writer behind)",
+            self.captured, self.written, self.dropped,
+        )
+
+    def summary(self) -> dict[str, int]:
+        return {"captured": self.captured, "written": self.written, "dropped": self.dropped}
@@ -0,0 +1,370 @@
+"""Entity-component core: game objects as rows in typed column arrays.
+
+An entity is just a row index. Each component is one `array.array` column, so
+a system walks a few flat arrays instead of chasing attributes through
+per-object dicts, and the same buffers can be handed to numpy or native code.
+
+Columns
+    position/hitbox  x, y, w, h                              (int32)
+    render           shape, color, color2, visual            (palette ids)
+    patrol           home_x, home_y, patrol, vertical, speed
+    health           hp
+    trigger          trigger, locked, solid
+
+`EntityView` adapts a row back into the sprite API, so the existing sprite
+classes can be layered on top (see the Ecs* classes in game.py).
+"""
+
+from __future__ import annotations
+
+import os
+from array import array
+from typing import Any, Iterable, Sequence
+
+import pygame
+
+# Kinds
+WALL, COIN, GOAL, HAZARD, PLAYER = range(5)
+
+# Shapes (render)
+RECT, CIRCLE, TRIANGLE = range(3)
+
+# Trigger responses
+NO_TRIGGER, PICKUP, DAMAGE, REACH = range(4)
+
+_COLUMNS = (
+    ("kind", "B"),
+    ("alive", "B"),
+    ("x", "i"),
+    ("y", "i"),
+    ("w", "i"),
+    ("h", "i"),
+    ("shape", "B"),
+    ("color", "H"),
+    ("color2", "H"),
+    ("visual", "H"),
+    ("home_x", "d"),
+    ("home_y", "d"),
+    ("patrol", "i"),
+    ("vertical", "B"),
+    ("speed", "d"),
+    ("hp", "i"),
+    ("trigger", "B"),
+    ("locked", "B"),
+    ("solid", "B"),
+)
+
+class World:
+    """Column storage for every entity in a level. Dead rows are recycled."""
+
+    def __init__(self) -> None:
+        for name, code in _COLUMNS:
+            setattr(self, name, array(code))
+        self.kind: array[int]
+        self.alive: array[int]
+        self.x: array[int]
+        self.y: array[int]
+        self.w: array[int]
+        self.h: array[int]
+        self.shape: array[int]
+        self.color: array[int]
+        self.color2: array[int]
+        self.visual: array[int]
+        self.home_x: array[float]
+        self.home_y: array[float]
+        self.patrol: array[int]
+        self.vertical: array[int]
+        self.speed: array[float]
+        self.hp: array[int]
+        self.trigger: array[int]
+        self.locked: array[int]
+        self.solid: array[int]
+
+        # Row -> sprite adapter, for handing system results back to game code
+        self.views: list[Any] = []
+        self.palette: list[pygame.Color] = []
+        # Same colours as tuples, for art looks
+        self.rgba: list[tuple[int, int, int, int]] = []
+        # Row -> (unlocked, locked) art looks, filled in by the render system
+        self.looks: list[tuple[tuple, tuple] | None] = []
+        self._color_ids: dict[tuple[int, int, int, int], int] = {}
+        self._free: list[int] = []
+
+    def __len__(self) -> int:
+        return len(self.kind)
+
+    def spawn(self, kind: int) -> int:
+        if self._free:
+            eid = self._free.pop()
+            for name, _ in _COLUMNS:
+                getattr(self, name)[eid] = 0
+            self.looks[eid] = None
+        else:
+            eid = len(self.kind)
+            for name, _ in _COLUMNS:
+                getattr(self, name).append(0)
+            self.views.append(None)
+            self.looks.append(None)
+        self.kind[eid] = kind
+        self.alive[eid] = 1
+        return eid
+
+    def despawn(self, eid: int) -> None:
+        if self.alive[eid]:
+            self.alive[eid] = 0
+            self.views[eid] = None
+            self._free.append(eid)
+
+    def copy(self) -> World:
+        """Columns and palette only; the copy has no sprite views."""
+        other = World()
+        for name, code in _COLUMNS:
+            setattr(other, name, array(code, getattr(self, name)))
+        other.views = [None] * len(self)
+        other.palette = list(self.palette)
+        other.rgba = list(self.rgba)
+        other.looks = list(self.looks)
+        other._color_ids = dict(self._color_ids)
+        other._free = list(self._free)
+        return other
+
+    def color_id(self, color: pygame.Color) -> int:
+        key = tuple(color)
+        cid = self._color_ids.get(key)
+        if cid is None:
+            cid = self._color_ids[key] = len(self.palette)
+            self.palette.append(pygame.Color(color))
+            self.rgba.append(tuple(color))
+        return cid
+
+    def rect(self, eid: int) -> pygame.Rect:
+        return pygame.Rect(self.x[eid], self.y[eid], self.w[eid], self.h[eid])
+
+    def set_rect(self, eid: int, r: pygame.Rect) -> None:
+        self.x[eid], self.y[eid], self.w[eid], self.h[eid] = r
+
+
+# Systems
+
+
+def patrol_offset(t: float, dx: float, speed: float) -> tuple[float, int]:
+    """Closed-form patrol: triangle wave home -> +dx -> -dx -> home, plus direction."""
+    if dx <= 0 or speed <= 0:
+        return 0.0, 1
+    lap = 4 * dx
+    s = (speed * t) % lap
+    if s < dx:
+        return s, 1
+    if s < 3 * dx:
+        return 2 * dx - s, -1
+    return s - lap, 1
+
+
+def patrol_one(world: World, eid: int, t: float) -> None:
+    offset, _ = patrol_offset(t, world.patrol[eid], world.speed[eid])
+    # Same rounding as Rect.centerx/centery assignment
+    if world.vertical[eid]:
+        world.y[eid] = round(world.home_y[eid] + offset) - world.h[eid] // 2
+    else:
+        world.x[eid] = round(world.home_x[eid] + offset) - world.w[eid] // 2
+
+
+def py_patrol(world: World, t: float, eids: Sequence[int] | None = None) -> None:
+    """Movement system: live patrolling rows (eids, or all of them) to their positions at time t."""
+    alive, speed = world.alive, world.speed
+    for eid in range(len(world)) if eids is None else eids:
+        if alive[eid] and speed[eid] > 0:
+            patrol_one(world, eid, t)
+
+
+def py_move_axis(world: World, eid: int, axis: int, amount: float, rows: Sequence[int] | None = None) -> None:
+    """Collision system: axis-separated move of one row against the solid rows.
+
+    Mirrors Game._move_player_axis: hits are gathered at the moved position
+    and each one then snaps the mover flush to that wall's face. `rows`
+    narrows the rows tested (ascending, e.g. from a spatial query covering
+    the move); by default every row is.
+    """
+    xs, ys, ws, hs = world.x, world.y, world.w, world.h
+    if axis == 0:
+        xs[eid] += int(round(amount))
+    else:
+        ys[eid] += int(round(amount))
+
+    px, py, pw, ph = xs[eid], ys[eid], ws[eid], hs[eid]
+    alive, solid = world.alive, world.solid
+    hits = [
+        s
+        for s in (range(len(world)) if rows is None else rows)
+        if solid[s] and alive[s] and s != eid
+        and px < xs[s] + ws[s] and xs[s] < px + pw and py < ys[s] + hs[s] and ys[s] < py + ph
+    ]
+    for s in hits:
+        if axis == 0:
+            if amount > 0:
+                xs[eid] = xs[s] - pw
+            elif amount < 0:
+                xs[eid] = xs[s] + ws[s]
+        else:
+            if amount > 0:
+                ys[eid] = ys[s] - ph
+            elif amount < 0:
+                ys[eid] = ys[s] + hs[s]
+
+
+def py_overlaps(world: World, eid: int, trigger: int, rows: Sequence[int] | None = None) -> list[int]:
+    """Trigger system: live rows with the given trigger that overlap row eid (among `rows`, if given)."""
+    xs, ys, ws, hs = world.x, world.y, world.w, world.h
+    px, py, pw, ph = xs[eid], ys[eid], ws[eid], hs[eid]
+    alive, trig = world.alive, world.trigger
+    return [
+        t
+        for t in (range(len(world)) if rows is None else rows)
+        if trig[t] == trigger and alive[t] and t != eid
+        and px < xs[t] + ws[t] and xs[t] < px + pw and py < ys[t] + hs[t] and ys[t] < py + ph
+    ]
+
+
+_LOOKS = {RECT: "rect", CIRCLE: "circle", TRIANGLE: "triangle"}
+
+
+def _looks(world: World, eid: int) -> tuple[tuple, tuple]:
+    # (unlocked, locked) looks of a row; size, shape and colours do not change after spawn
+    c, c2 = world.rgba[world.color[eid]], world.rgba[world.color2[eid]]
+    shape = world.shape[eid]
+    if shape == CIRCLE:
+        r = world.visual[eid] // 2
+        return ("circle", r, c), ("circle", r, c2)
+    w, h = world.w[eid], world.h[eid]
+    return (_LOOKS[shape], w, h, c), (_LOOKS[shape], w, h, c2)
+
+
+def sprites(world: World, eids: Iterable[int], out: list) -> list[tuple[tuple, int, int]]:
+    """Render system: appends (look, anchor x, anchor y) per row to out, exactly as the sprite classes' `art`."""
+    xs, ys, ws, hs = world.x, world.y, world.w, world.h
+    shapes, locked, looks = world.shape, world.locked, world.looks
+    for eid in eids:
+        pair = looks[eid]
+        if pair is None:
+            pair = looks[eid] = _looks(world, eid)
+        look = pair[locked[eid]]
+        if shapes[eid] == CIRCLE:
+            # Art is visual-sized around the hitbox centre
+            out.append((look, xs[eid] + ws[eid] // 2, ys[eid] + hs[eid] // 2))
+        else:
+            out.append((look, xs[eid], ys[eid]))
+    return out
+
+
+# Kernel selection. The native module (setup.py build_ext --inplace) implements
+# the same three systems in C++; the py_* versions above are the fallback and
+# the reference it is checked against.
+
+try:
+    from . import _kernel
+except ImportError:
+    _kernel = None
+
+patrol = py_patrol
+move_axis = py_move_axis
+overlaps = py_overlaps
+
+
+def use_native(enabled: bool = True) -> bool:
+    """Switch the hot systems to the native kernels if built; returns whether they are active."""
+    global patrol, move_axis, overlaps
+    if enabled and _kernel is not None:
+        patrol, move_axis, overlaps = _kernel.patrol, _kernel.move_axis, _kernel.overlaps
+        return True
+    patrol, move_axis, overlaps = py_patrol, py_move_axis, py_overlaps
+    return False
+
+
+use_native(os.environ.get("SPRITES_KERNELS", "native") != "python")
+
+
+# Sprite adapter
+
+
+class _BoundRect(pygame.Rect):
+    """Rect that writes every attribute assignment back to its entity row.
+
+    `rect.x += 3` and `rect.center = c` both go through __setattr__, so the
+    existing sprite code keeps working. The in-place methods (move_ip etc.)
+    do not; assign the result instead.
+    """
+
+    def __setattr__(self, name: str, value: Any) -> None:
+        super().__setattr__(name, value)
+        world = self.__dict__.get("_world")
+        if world is not None and name[0] != "_":
+            world.set_rect(self.__dict__["_eid"], self)
+
+
+class EntityView(pygame.sprite.Sprite):
+    """Sprite whose rect, render info and health live in World columns.
+
+    Put it first in the bases of an existing sprite class; the class's own
+    __init__ then writes straight into the row through these properties.
+    """
+
+    KIND = WALL
+
+    def __init__(self, world: World, *args: Any, **kwargs: Any) -> None:
+        self._world = world
+        self.entity = world.spawn(self.KIND)
+        world.views[self.entity] = self
+        super().__init__(*args, **kwargs)
+
+    @property
+    def rect(self) -> pygame.Rect:
+        # One bound rect per view, refreshed from the row on every read (update() is a
+        # method call, so it does not write back)
+        world, eid = self._world, self.entity
+        r = self.__dict__.get("_rect")
+        if r is None:
+            r = self._rect = _BoundRect(0, 0, 0, 0)
+            r._world = world
+            r._eid = eid
+        r.update(world.x[eid], world.y[eid], world.w[eid], world.h[eid])
+        return r
+
+    @rect.setter
+    def rect(self, value: pygame.Rect) -> None:
+        self._world.set_rect(self.entity, value)
+
+    @property
+    def color(self) -> pygame.Color:
+        return self._world.palette[self._world.color[self.entity]]
+
+    @color.setter
+    def color(self, value: pygame.Color) -> None:
+        self._world.color[self.entity] = self._world.color_id(value)
+
+    @property
+    def visual_size(self) -> int:
+        return self._world.visual[self.entity]
+
+    @visual_size.setter
+    def visual_size(self, value: int) -> None:
+        self._world.visual[self.entity] = value
+
+    @property
+    def hp(self) -> int:
+        return self._world.hp[self.entity]
+
+    @hp.setter
+    def hp(self, value: int) -> None:
+        self._world.hp[self.entity] = value
+
+    @property
+    def locked(self) -> bool:
+        return bool(self._world.locked[self.entity])
+
+    @locked.setter
+    def locked(self, value: bool) -> None:
+        self._world.locked[self.entity] = int(value)
+
+    def kill(self) -> None:
+        self._world.despawn(self.entity)
+        super().kill()
@@ -5,9 +5,34 @@ from dataclasses import dataclass, field
 from pathlib import Path
 
 import random
+import threading
 
+from typing import TYPE_CHECKING, Callable
+
+import numpy as np
 import pygame
 
+from . import ecs, levels
+from .aabb import BoxSet
+from .activity import ActivityRegions
+from .art import BLOCK, CIRCLE, RECT, SPRITES, TRIANGLE, ArtCache, Look
+from .camera import Camera
+from .canvas import Canvas
+from .capture import FrameCapture
+from .gcpolicy import GcPolicy
+from .heatmap import COINS, DAMAGE, Heatmap
+from .levels import HazardSpec, LevelSpec
+from .particles import COIN, DAMAGE as BURST_DAMAGE, DOT_LOOKS, UNLOCK, ParticlePool
+from .pipeline import FrameSnapshot
+from .quality import TIERS, Tier
+from .spatial import SpatialGrid
+from .streaming import ChunkStreamer
+from .tiles import TileCache
+from .trace import OFF, NullTracer, Tracer
+
+if TYPE_CHECKING:
+    from .textures import TextureRenderer
+
 
 @dataclass(frozen=True)
 class Palette:
@@ -28,14 +53,49 @@ def _clamp(value: float, lo: float, hi: float) -> float:
     return max(lo, min(hi, value))
 
 
-class Wall(pygame.sprite.Sprite):
+# Draw order, bottom to top (Sprite._layer). Walls are baked into the background tiles.
+WALL_LAYER, COIN_LAYER, HAZARD_LAYER, GOAL_LAYER, PLAYER_LAYER = range(5)
+
+# Player colour on alternate blink frames while invincible
+_BLINK = (0xD8, 0xDE, 0xE9, 0xFF)
+_BLACK = pygame.Color("#000000")
+_NO_SHAKE = (0.0, 0.0)
+
+
+class Drawn(pygame.sprite.Sprite):
+    """A sprite whose picture is a look (see art.py) placed at an anchor point.
+
+    `rect` stays the hitbox. `art` is (look, anchor x, anchor y) in world
+    pixels; renderers turn that into one blit. `image` is the look at scale
+    1, which lands at the anchor plus the art offset, not at rect.topleft.
+    """
+
+    @property
+    def art(self) -> tuple[Look, int, int]:
+        raise NotImplementedError
+
+    @property
+    def image(self) -> pygame.Surface:
+        return SPRITES.place(*self.art)[0]
+
+
+class Wall(Drawn):
+    _layer = WALL_LAYER
+
     def __init__(self, rect: pygame.Rect, color: pygame.Color) -> None:
         super().__init__()
         self.rect = rect.copy()
         self.color = color
 
+    @property
+    def art(self) -> tuple[Look, int, int]:
+        r = self.rect
+        return (BLOCK, r.w, r.h, tuple(self.color)), r.x, r.y
+
+
+class Coin(Drawn):
+    _layer = COIN_LAYER
 
-class Coin(pygame.sprite.Sprite):
     def __init__(
         self,
         center: tuple[int, int],
@@ -50,8 +110,18 @@ class Coin(pygame.sprite.Sprite):
 
         self.visual_size = visual_size
         self.color = color
+        # Fixed at spawn, so art only adds the position
+        self.look = (CIRCLE, visual_size // 2, tuple(color))
+
+    @property
+    def art(self) -> tuple[Look, int, int]:
+        # Bigger art than hitbox, centred on it
+        return self.look, *self.rect.center
+
+
+class Goal(Drawn):
+    _layer = GOAL_LAYER
 
-class Goal(pygame.sprite.Sprite):
     def __init__(
             self,
             center: tuple[int, int],
@@ -72,9 +142,21 @@ class Goal(pygame.sprite.Sprite):
         self.locked_color = locked_color
         self.locked = locked
         self.coins_needed = coins_needed
-    
+        # (unlocked, locked)
+        self._looks = (
+            (RECT, hitbox_size, hitbox_size, tuple(color)),
+            (RECT, hitbox_size, hitbox_size, tuple(locked_color)),
+        )
+
+    @property
+    def art(self) -> tuple[Look, int, int]:
+        r = self.rect
+        return self._looks[self.locked], r.x, r.y
+
+
+class Hazard(Drawn):
+    _layer = HAZARD_LAYER
 
-class Hazard(pygame.sprite.Sprite):
     def __init__(
         self,
         center: tuple[int, int],
@@ -90,6 +172,7 @@ class Hazard(pygame.sprite.Sprite):
         self.rect = pygame.Rect(0, 0, size, size)
         self.rect.center = center
         self.color = color
+        self.look = (TRIANGLE, size, size, tuple(color))
 
         self.home = pygame.Vector2(center)
         self.patrol_dx = patrol_dx
@@ -97,30 +180,68 @@ class Hazard(pygame.sprite.Sprite):
         self.speed = speed
 
         self.direction = 1
+        # Seconds of patrol elapsed; the position is a pure function of this
+        self.t = 0.0
+        self._envelope: pygame.Rect | None = None
+        # Game's packed trigger boxes, kept in step with the rect
+        self.boxes: BoxSet[Hazard] | None = None
 
-    def update(self, dt: float) -> None:
-    #Conditional which determines axis of movement
-        if self.isVertical == False:
-            x = self.rect.centerx + self.direction * self.speed * dt
-            if x < self.home.x - self.patrol_dx:
-                x = self.home.x - self.patrol_dx
-                self.direction = 1
-            elif x > self.home.x + self.patrol_dx:
-                x = self.home.x + self.patrol_dx
-                self.direction = -1
-            self.rect.centerx = int(x)
+    @property
+    def art(self) -> tuple[Look, int, int]:
+        r = self.rect
+        return self.look, r.x, r.y
+
+    def envelope(self) -> pygame.Rect:
+        """Everything this hazard can touch over one full patrol (cached, do not mutate)."""
+        if self._envelope is None:
+            w, h = self.rect.size
+            if self.isVertical:
+                env = pygame.Rect(0, 0, w, 2 * self.patrol_dx + h)
+            else:
+                env = pygame.Rect(0, 0, 2 * self.patrol_dx + w, h)
+            env.center = (round(self.home.x), round(self.home.y))
+            self._envelope = env
+        return self._envelope
+
+    def offset_at(self, t: float) -> tuple[float, int]:
+        """Closed-form patrol: a triangle wave home -> +dx -> -dx -> home.
+
+        Returns the signed offset from home along the patrol axis and the
+        direction of travel at time t. One lap takes 4 * patrol_dx / speed.
+        """
+        return ecs.patrol_offset(t, self.patrol_dx, self.speed)
+
+    def position_at(self, t: float) -> tuple[int, int]:
+        offset, _ = self.offset_at(t)
+        if self.isVertical:
+            return int(self.home.x), round(self.home.y + offset)
+        return round(self.home.x + offset), int(self.home.y)
+
+    def advance(self, dt: float) -> None:
+        # Time only; the rect is stale until sync(). Lets idle hazards skip the work.
+        self.t += dt
+
+    def sync(self) -> None:
+        offset, self.direction = self.offset_at(self.t)
+        if self.isVertical:
+            self.rect.centery = round(self.home.y + offset)
         else:
-            y = self.rect.centery + self.direction * self.speed * dt
-            if y < self.home.y - self.patrol_dx:
-                y = self.home.y - self.patrol_dx
-                self.direction = 1
-            elif y > self.home.y + self.patrol_dx:
-                y = self.home.y + self.patrol_dx
-                self.direction = -1
-            self.rect.centery = int(y)
-        
-       
-class Player(pygame.sprite.Sprite):
+            self.rect.centerx = round(self.home.x + offset)
+        if self.boxes is not None:
+            self.boxes.move(self, self.rect)
+
+    def seek(self, t: float) -> None:
+        self.t = t
+        self.sync()
+
+    def update(self, dt: float) -> None:
+        self.advance(dt)
+        self.sync()
+
+
+class Player(Drawn):
+    _layer = PLAYER_LAYER
+
     def __init__(
         self,
         center: tuple[int, int],
@@ -136,6 +257,8 @@ class Player(pygame.sprite.Sprite):
 
         self.visual_size = visual_size
         self.color = color
+        # (normal, blink)
+        self._looks = ((CIRCLE, visual_size // 2, tuple(color)), (CIRCLE, visual_size // 2, _BLINK))
 
         self.vel = pygame.Vector2(0, 0)
         self.speed = 320.0
@@ -148,6 +271,76 @@ class Player(pygame.sprite.Sprite):
     def is_invincible(self) -> bool:
         return self.invincible_for > 0
 
+    @property
+    def art(self) -> tuple[Look, int, int]:
+        # Simple blink while invincible
+        blink = self.is_invincible and int(self.invincible_for * 16) % 2 == 0
+        return self._looks[blink], *self.rect.center
+
+
+# ECS-backed variants of the sprites above (Game(use_ecs=True)). Same classes and
+# constructors; EntityView puts their data in World columns for the systems in ecs.py.
+
+
+class EcsWall(ecs.EntityView, Wall):
+    KIND = ecs.WALL
+
+    def __init__(self, world: ecs.World, *args, **kwargs) -> None:
+        super().__init__(world, *args, **kwargs)
+        world.shape[self.entity] = ecs.RECT
+        world.solid[self.entity] = 1
+
+
+class EcsCoin(ecs.EntityView, Coin):
+    KIND = ecs.COIN
+
+    def __init__(self, world: ecs.World, *args, **kwargs) -> None:
+        super().__init__(world, *args, **kwargs)
+        world.shape[self.entity] = ecs.CIRCLE
+        world.trigger[self.entity] = ecs.PICKUP
+
+
+class EcsGoal(ecs.EntityView, Goal):
+    KIND = ecs.GOAL
+
+    def __init__(self, world: ecs.World, *args, **kwargs) -> None:
+        super().__init__(world, *args, **kwargs)
+        world.shape[self.entity] = ecs.RECT
+        world.trigger[self.entity] = ecs.REACH
+        world.color2[self.entity] = world.color_id(self.locked_color)
+
+
+class EcsHazard(ecs.EntityView, Hazard):
+    KIND = ecs.HAZARD
+
+    def __init__(self, world: ecs.World, *args, **kwargs) -> None:
+        super().__init__(world, *args, **kwargs)
+        eid = self.entity
+        world.shape[eid] = ecs.TRIANGLE
+        world.trigger[eid] = ecs.DAMAGE
+        world.home_x[eid] = self.home.x
+        world.home_y[eid] = self.home.y
+        world.patrol[eid] = self.patrol_dx
+        world.vertical[eid] = int(self.isVertical)
+        world.speed[eid] = self.speed
+
+    def sync(self) -> None:
+        _, self.direction = self.offset_at(self.t)
+        ecs.patrol_one(self._world, self.entity, self.t)
+
+
+class EcsPlayer(ecs.EntityView, Player):
+    KIND = ecs.PLAYER
+
+
+ECS_VIEWS: dict[type, type] = {
+    Wall: EcsWall,
+    Coin: EcsCoin,
+    Goal: EcsGoal,
+    Hazard: EcsHazard,
+    Player: EcsPlayer,
+}
+
 
 class Game:
     fps = 60
@@ -156,12 +349,69 @@ class Game:
     HUD_H = 56
     PADDING = 12
 
-    def __init__(self) -> None:
+    CENTER_MESSAGES = {
+        "title": "Sprites + Collisions\nCollect all coins to unlock Goal and win!\nPress Space to start",
+        "gameover": "Game over\nPress Space to restart",
+        "win": "You Win!\nPress Space to play again",
+    }
+
+    @classmethod
+    def playfield_rect(cls) -> pygame.Rect:
+        return pygame.Rect(
+            cls.PADDING,
+            cls.HUD_H + cls.PADDING,
+            cls.SCREEN_W - 2 * cls.PADDING,
+            cls.SCREEN_H - cls.HUD_H - 2 * cls.PADDING,
+        )
+
+    def __init__(
+        self,
+        *,
+        level: Callable[[pygame.Rect], LevelSpec] = levels.arena,
+        use_ecs: bool = False,
+        renderer: str = "surface",
+        render_scale: float = 1.0,
+        window: tuple[int, int] | None = None,
+        smooth: bool = False,
+        seed: int | None = None,
+        tracer: Tracer | NullTracer = OFF,
+        gc_policy: GcPolicy | None = None,
+    ) -> None:
         self.palette = Palette()
+        # Frame phase spans (trace.py); OFF records nothing
+        self.tracer = tracer
+        # Freezes each loaded level and reports GC pauses in the debug HUD (gcpolicy.py)
+        self.gc_policy = gc_policy
+        self.level = level
+        # With use_ecs, level objects are rows in an ecs.World and update/draw run its systems
+        self.use_ecs = use_ecs
+        self.entities: ecs.World | None = None
+
+        # Internal resolution is SCREEN_W x SCREEN_H times render_scale, whatever the window size
+        self.render_scale = render_scale
+        # What rendering may cost; a QualityGovernor lowers it when frames run over budget
+        self.quality = TIERS[0]
+        # Tier asked for by request_quality(), applied by the next present()
+        self._wanted_quality: Tier | None = None
+        # Held while the render scale changes, and while a level load reads it for the new TileCache
+        self.scale_lock = threading.Lock()
+        self.canvas = Canvas(
+            (self.SCREEN_W, self.SCREEN_H),
+            scale=render_scale,
+            window=window,
+            smooth=smooth,
+            display=(renderer == "surface"),
+        )
+        # Sprite images at the canvas scale
+        self.art = ArtCache(scale=self.canvas.scale)
+        # "surface" draws in software onto the canvas; "texture" uses an SDL2 Renderer
+        self.backend: TextureRenderer | None = None
+        if renderer == "texture":
+            from .textures import TextureRenderer
 
-        self.screen = pygame.display.set_mode((self.SCREEN_W, self.SCREEN_H))
-        self.font = pygame.font.SysFont(None, 22)
-        self.big_font = pygame.font.SysFont(None, 40)
+            # The canvas stays offscreen: pixel format template and the target of draw()
+            self.backend = TextureRenderer(self, title=(pygame.display.get_caption() or ("pygame",))[0])
+        self._load_fonts()
 
         #initialize sfx
         base_path = Path(__file__).parent
@@ -181,14 +431,25 @@ class Game:
         self.muted = False
 
         self.screen_rect = pygame.Rect(0, 0, self.SCREEN_W, self.SCREEN_H)
-        self.playfield = pygame.Rect(
-            self.PADDING,
-            self.HUD_H + self.PADDING,
-            self.SCREEN_W - 2 * self.PADDING,
-            self.SCREEN_H - self.HUD_H - 2 * self.PADDING,
-        )
+        # Everything below the HUD line; world drawing is clipped to it
+        self.world_clip = pygame.Rect(0, self.HUD_H + 1, self.SCREEN_W, self.SCREEN_H - self.HUD_H - 1)
+        self.playfield = self.playfield_rect()
+        self._layout()
+        # Render-side scratch (render may run on another thread than snapshot)
+        self._render_view = pygame.Rect(0, 0, 0, 0)
+        self._blit_items: list[tuple[pygame.Surface, tuple[int, int]]] = []
+        # Particle dot art keys and anchor offsets, for the render scale they were made at
+        self._dot_scale: float | None = None
+        self._dot_keys: list[tuple] = []
+        self._dot_offsets = np.zeros((len(DOT_LOOKS), 2), np.int32)
         self.debug = False
         self.state = "title"  # title | play | gameover | win
+        # Optional AutoPilot; when set it replaces keyboard input in update()
+        self.autopilot = None
+        # Optional FrameCapture; present() hands it every frame (F12 makes one on demand)
+        self.capture: FrameCapture | None = None
+        # Optional Heatmap of where the player goes, gets hurt and picks up coins
+        self.telemetry: Heatmap | None = None
 
         self.all_sprites: pygame.sprite.Group[pygame.sprite.Sprite] = pygame.sprite.Group()
         self.walls: pygame.sprite.Group[Wall] = pygame.sprite.Group()
@@ -200,89 +461,246 @@ class Game:
         self.all_sprites.add(self.player)
 
         self._shake = 0.0
+        # Shake draws from here; particles use their own numpy generator, seeded the same
+        self.rng = random.Random(seed)
+        # Pickup, damage and unlock bursts (particles.py)
+        self.particles = ParticlePool(seed=seed)
+        # Offscreen world layer for shaking frames, made on first use
+        self._layer: pygame.Surface | None = None
+        # Draw calls made by the last render (debug view)
+        self.draw_calls = 0
+        # HUD text as last shown, and seconds since it changed (throttled by the quality tier)
+        self._hud = ""
+        self._hud_age = float("inf")
+        # HUD text for the current (score, hp, i-frames, muted); rebuilt only when those change
+        self._hud_key: tuple | None = None
+        self._hud_want = ""
+        # Scratch reused by every frame, so a steady frame allocates next to nothing
+        self._move = pygame.Vector2()
+        self._view = pygame.Rect(0, 0, 0, 0)
+        self._coins: list[Coin] = []
+        self._hazards: list[Hazard] = []
+        self._goals: list[Goal] = []
+        self._sprites: list[tuple[Look, int, int]] = []
+        self._eids: list[int] = []
+        # ECS collision candidates: sprites from a spatial query, then their rows
+        self._near: list = []
+        self._near_eids: list[int] = []
+        self._reach = pygame.Rect(0, 0, 0, 0)
+        self.activity = ActivityRegions()
+        self.streamer: ChunkStreamer | None = None
+        self.tiles: TileCache | None = None
+        # Bumped whenever walls or hazards come or go (reset, chunk streaming); the autopilot
+        # rebuilds its grid from it the next time it plans
+        self.layout_version = 0
         self._reset_level(keep_state=True)
 
+    @property
+    def screen(self) -> pygame.Surface:
+        return self.canvas.surface
+
+    def _load_fonts(self) -> None:
+        self.font = pygame.font.SysFont(None, self.canvas.px(22))
+        self.big_font = pygame.font.SysFont(None, self.canvas.px(40))
+        self._texts: dict[tuple, pygame.Surface] = {}
+
+    def _layout(self) -> None:
+        # Fixed HUD geometry in internal pixels, worked out once per render scale instead of every frame
+        c = self.canvas
+        self._panel_rect = c.rect((0, 0, self.SCREEN_W, self.HUD_H))
+        self._rule = (c.point((0, self.HUD_H)), c.point((self.SCREEN_W, self.HUD_H)), c.width(1))
+        self._hud_at, self._hint_at = c.point((14, 18)), c.point((14, 36))
+        self._clip = c.rect(self.world_clip)
+        # Translucent panel behind the centre message, made on first use at this scale
+        self._overlay_at = c.rect(self.playfield)
+        self._overlay: pygame.Surface | None = None
+
+    def _text(self, font: pygame.font.Font, text: str, color: pygame.Color) -> pygame.Surface:
+        # HUD strings change a few times a minute; rendering them every frame is most of the HUD's cost
+        key = (id(font), text, tuple(color))
+        surf = self._texts.get(key)
+        if surf is None:
+            if len(self._texts) > 64:
+                self._texts.clear()
+            surf = self._texts[key] = font.render(text, True, color)
+        return surf
+
+    def set_render_scale(self, scale: float) -> None:
+        """Change the internal resolution; tiles and fonts are rebuilt for it."""
+        self.canvas.set_scale(scale)
+        self.art.set_scale(scale)
+        self._load_fonts()
+        self._layout()
+        self.tiles.set_scale(scale)
+        if self.backend is not None:
+            self.backend.resize()
+
+    def set_quality(self, tier: Tier) -> None:
+        """Switch quality tier now; call only where rendering runs (or before the loop starts)."""
+        with self.scale_lock:
+            self.quality = tier
+            scale = self.render_scale * tier.scale
+            if scale != self.canvas.scale:
+                self.set_render_scale(scale)
+
+    def request_quality(self, tier: Tier) -> None:
+        """Switch quality tier at the start of the next present(), on the thread that renders."""
+        self._wanted_quality = tier
+
     def _reset_level(self, *, keep_state: bool = False) -> None:
+        if self.streamer is not None:
+            self.streamer.close()
+            self.streamer = None
+
         self.all_sprites.empty()
         self.walls.empty()
         self.coins.empty()
         self.hazards.empty()
         self.goals.empty()
 
-        self.player = Player((self.playfield.left + 75, self.playfield.top + 380), color=self.palette.player)
+        # Hazards are bucketed by patrol envelope so the index never needs updating as they move
+        self.wall_index: SpatialGrid[Wall] = SpatialGrid()
+        self.coin_index: SpatialGrid[Coin] = SpatialGrid()
+        self.hazard_index: SpatialGrid[Hazard] = SpatialGrid()
+        self.goal_index: SpatialGrid[Goal] = SpatialGrid()
+        self.entities = ecs.World() if self.use_ecs else None
+        # Packed boxes for the wall and trigger checks; ECS mode tests its own columns instead
+        self.wall_boxes: BoxSet[Wall] | None = None
+        self.coin_boxes: BoxSet[Coin] | None = None
+        self.hazard_boxes: BoxSet[Hazard] | None = None
+        self.goal_boxes: BoxSet[Goal] | None = None
+        if self.entities is None:
+            self.wall_boxes, self.coin_boxes, self.hazard_boxes, self.goal_boxes = BoxSet(), BoxSet(), BoxSet(), BoxSet()
+        if self.tiles is not None:
+            self.tiles.close()
+        # Pipelined, a tier change may be rescaling the canvas on the render thread right now
+        with self.scale_lock:
+            self.tiles = TileCache(self.wall_index.query, self.palette.bg, self.screen, scale=self.canvas.scale)
+        self.activity.reset()
+        self.particles.clear()
+        self.layout_version += 1
+
+        spec = self.level(self.playfield)
+        self.world = pygame.Rect(spec.world)
+
+        self.player = self._spawn(Player, spec.player_start, color=self.palette.player)
         self.all_sprites.add(self.player)
 
-        def add_wall(r: pygame.Rect) -> None:
-            wall = Wall(r, self.palette.wall)
-            self.walls.add(wall)
-            self.all_sprites.add(wall)
-
-        t = 16
-        # Arena boundary (solid)
-        add_wall(pygame.Rect(self.playfield.left, self.playfield.top, self.playfield.width, t))
-        add_wall(pygame.Rect(self.playfield.left, self.playfield.bottom - t, self.playfield.width, t))
-        add_wall(pygame.Rect(self.playfield.left, self.playfield.top, t, self.playfield.height))
-        add_wall(pygame.Rect(self.playfield.right - t, self.playfield.top, t, self.playfield.height))
-
-        # Interior walls (solid)
-        add_wall(pygame.Rect(self.playfield.left + 400, self.playfield.top + 145, 125, 18))
-        add_wall(pygame.Rect(self.playfield.left + 650, self.playfield.top + 145, 275, 18))
-        add_wall(pygame.Rect(self.playfield.left + 150, self.playfield.top + 200, 125, 18))
-        add_wall(pygame.Rect(self.playfield.left + 150, self.playfield.top + 100, 125, 18))
-        add_wall(pygame.Rect(self.playfield.left, self.playfield.top + 300, 650, 18))
-        add_wall(pygame.Rect(self.playfield.left + 750, self.playfield.top + 355, 90, 18))
-        
+        # Walls (solid)
+        for r in spec.walls:
+            self.add_wall(pygame.Rect(r))
 
         # Hazards (damage)
-        h1 = Hazard(
-            (self.playfield.left + 587, 
-             self.playfield.top + 150), 
-             color=self.palette.hazard,
-             patrol_dx = 75,
-             isVertical = True,
-             speed = 200.0
-             )
-        h2 = Hazard(
-            (self.playfield.left + 200, self.playfield.top + 255),
-            color=self.palette.hazard,
-            patrol_dx= 160,
-            speed=200.0,
-        )
-        h3 = Hazard(
-            (self.playfield.left + 200, self.playfield.top + 55),
-            color=self.palette.hazard,
-            patrol_dx= 160,
-            speed= 200.0,
+        for hs in spec.hazards:
+            self.add_hazard(hs)
 
-        )
         # Goal (trigger)
-        goal = Goal(
-            (self.playfield.left + 75, self.playfield.top + 380),  
+        goal = self._spawn(
+            Goal,
+            spec.goal,
             color = self.palette.goal,
             locked_color= self.palette.goal_locked,
             locked= True,
-            coins_needed = 7
+            coins_needed = spec.coins_needed
         )
         self.goals.add(goal)
-        self.hazards.add(h1, h2, h3)
-        self.all_sprites.add(h1, h2, h3, goal)
+        self.all_sprites.add(goal)
+        self.goal_index.insert(goal, goal.rect)
+        if self.goal_boxes is not None:
+            self.goal_boxes.add(goal, goal.rect)
 
         # Coins (trigger)
-        c1 = Coin((self.playfield.left + 275, self.playfield.top + 380), color=self.palette.coin)
-        c2 = Coin((self.playfield.left + 500, self.playfield.top + 380), color=self.palette.coin)
-        c3 = Coin((self.playfield.left + 795, self.playfield.top + 250), color=self.palette.coin)
-        c4 = Coin((self.playfield.left + 790, self.playfield.top + 70), color=self.palette.coin)
-        c5 = Coin((self.playfield.left + 340, self.playfield.top + 155), color=self.palette.coin)
-        c6 = Coin((self.playfield.left + 75, self.playfield.top + 57), color=self.palette.coin)
-        c7 = Coin((self.playfield.left + 75, self.playfield.top + 255), color=self.palette.coin)
-        
-        self.coins.add(c1,c2,c3,c4,c5,c6,c7)
-        self.all_sprites.add(c1,c2,c3,c4,c5,c6,c7)
- 
+        for center in spec.coins:
+            self.add_coin(center)
+
+        # Streamed levels keep everything else on disk and page it in around the player
+        if spec.chunks is not None:
+            self.streamer = ChunkStreamer(self, Path(spec.chunks))
+            self.streamer.load_around(self.player.rect.center)
+
+        self.camera = Camera(self.playfield, self.world)
+        self.camera.snap(self.player.rect.center)
+        self.tiles.warm(self.camera.view)
+
+        # Everything the level built lives until the next reset; keep the collector off it
+        if self.gc_policy is not None:
+            self.gc_policy.level_loaded()
+
         if not keep_state:
             self.state = "play"
 
+    def _spawn(self, cls: type, *args, **kwargs):
+        if self.entities is None:
+            return cls(*args, **kwargs)
+        return ECS_VIEWS[cls](self.entities, *args, **kwargs)
+
+    def add_wall(self, rect: pygame.Rect) -> Wall:
+        wall = self._spawn(Wall, rect, self.palette.wall)
+        self.walls.add(wall)
+        self.all_sprites.add(wall)
+        if self.wall_boxes is not None:
+            self.wall_boxes.add(wall, wall.rect)
+        with self.tiles.lock:
+            self.wall_index.insert(wall, wall.rect)
+            self.tiles.invalidate(wall.rect)
+        return wall
+
+    def add_hazard(self, hs: HazardSpec) -> Hazard:
+        hazard = self._spawn(
+            Hazard,
+            hs.center,
+            color=self.palette.hazard,
+            patrol_dx=hs.patrol_dx,
+            isVertical=hs.vertical,
+            speed=hs.speed,
+        )
+        if self.hazard_boxes is not None:
+            self.hazard_boxes.add(hazard, hazard.rect)
+            hazard.boxes = self.hazard_boxes
+        # Joins mid-level on the shared clock, exactly where it would have been
+        hazard.seek(self.activity.clock)
+        self.hazards.add(hazard)
+        self.all_sprites.add(hazard)
+        self.hazard_index.insert(hazard, hazard.envelope())
+        self.activity.invalidate()
+        return hazard
+
+    def add_coin(self, center: tuple[int, int]) -> Coin:
+        coin = self._spawn(Coin, center, color=self.palette.coin)
+        self.coins.add(coin)
+        self.all_sprites.add(coin)
+        self.coin_index.insert(coin, coin.rect)
+        if self.coin_boxes is not None:
+            self.coin_boxes.add(coin, coin.rect)
+        return coin
+
+    def remove_sprite(self, sprite: pygame.sprite.Sprite) -> None:
+        if isinstance(sprite, Wall):
+            # The render thread may be reading this wall through the tile cache
+            with self.tiles.lock:
+                sprite.kill()
+                self.wall_index.remove(sprite)
+                self.tiles.invalidate(sprite.rect)
+            if self.wall_boxes is not None:
+                self.wall_boxes.remove(sprite)
+            return
+
+        sprite.kill()
+        if isinstance(sprite, Coin):
+            self.coin_index.remove(sprite)
+            if self.coin_boxes is not None:
+                self.coin_boxes.remove(sprite)
+        elif isinstance(sprite, Hazard):
+            self.hazard_index.remove(sprite)
+            if self.hazard_boxes is not None:
+                self.hazard_boxes.remove(sprite)
+            self.activity.invalidate()
+
     def handle_event(self, event: pygame.event.Event) -> None:
+        with self.tracer.span("handle_event"):
+            self._handle_key(event)
+
+    def _handle_key(self, event: pygame.event.Event) -> None:
         if event.type != pygame.KEYDOWN:
             return
 
@@ -294,6 +712,17 @@ class Game:
             self.debug = not self.debug
             return
 
+        if event.key == pygame.K_F9:
+            # Timestamped copy of the trace so far; no-op unless tracing
+            self.tracer.dump()
+            return
+
+        if event.key == pygame.K_F12:
+            if self.capture is None:
+                self.capture = FrameCapture("captures", self.canvas.size, fps=self.fps)
+            self.capture.screenshot()
+            return
+
         if event.key == pygame.K_r:
             self._reset_level(keep_state=(self.state == "title"))
             return
@@ -321,18 +750,36 @@ class Game:
         if keys[pygame.K_DOWN] or keys[pygame.K_s]:
             y += 1
 
-        v = pygame.Vector2(x, y)
-        if v.length_squared() > 0:
-            v = v.normalize()
+        # Reused every frame; the caller copies it into the player's velocity
+        v = self._move
+        v.update(x, y)
+        if x or y:
+            v.normalize_ip()
         return v
 
     def _move_player_axis(self, axis: str, amount: float) -> None:
+        if self.entities is not None:
+            # Only walls the move can reach; rows ascending, so hits resolve in the same order
+            reach = self._reach
+            reach.update(self.player.rect)
+            step = abs(int(round(amount))) + 1
+            if axis == "x":
+                reach.inflate_ip(2 * step, 0)
+            else:
+                reach.inflate_ip(0, 2 * step)
+            # Pipelined, the render thread's tile cache queries this grid too
+            with self.tiles.lock:
+                rows = self._rows_near(self.wall_index, reach)
+            ecs.move_axis(self.entities, self.player.entity, 0 if axis == "x" else 1, amount, rows)
+            return
+
         if axis == "x":
             self.player.rect.x += int(round(amount))
         else:
             self.player.rect.y += int(round(amount))
 
-        hits = pygame.sprite.spritecollide(self.player, self.walls, dokill=False)
+        # Same hits in the same order as spritecollide(player, walls), without copying the group
+        hits = self.wall_boxes.hits(self.player.rect)
         if not hits:
             return
 
@@ -354,6 +801,9 @@ class Game:
 
         self.player.hp -= 1
         self.player.invincible_for = 0.75
+        self.particles.emit(BURST_DAMAGE, self.player.rect.center, 24)
+        if self.telemetry is not None:
+            self.telemetry.event(DAMAGE, self.player.rect.center)
         if not self.muted:
             self.hurt_sfx.play()
 
@@ -373,159 +823,381 @@ class Game:
         for goal in self.goals:
             if goal.locked and self.player.score >= goal.coins_needed:
                 goal.locked = False
+                self.particles.emit(UNLOCK, goal.rect.center, 48)
                 if not self.muted:
                     self.goal_sfx.play()
             
 
+    def _rows_near(self, index: SpatialGrid, rect: pygame.Rect) -> list[int]:
+        # ECS rows of what the index has around rect, ascending like a full scan would visit them
+        rows = self._near_eids
+        rows.clear()
+        for sprite in index.query(rect, self._near):
+            rows.append(sprite.entity)
+        rows.sort()
+        return rows
+
+    def _touching(self, boxes: BoxSet | None, index: SpatialGrid, trigger: int) -> list:
+        # One batched test per trigger kind, against the packed boxes or the ECS columns near the player
+        if boxes is not None:
+            return boxes.hits(self.player.rect)
+        rows = self._rows_near(index, self.player.rect)
+        if not rows:
+            return ()
+        hit = ecs.overlaps(self.entities, self.player.entity, trigger, rows)
+        if not hit:
+            return ()
+        views = self.entities.views
+        return [views[e] for e in hit]
+
     def update(self, dt: float) -> None:
+        self._hud_age += dt
         if self._shake > 0:
             self._shake = max(0.0, self._shake - dt)
+        # Bursts play out on the end screens too
+        self.particles.update(dt)
 
         if self.state != "play":
             return
 
-        move = self._read_move()
-        self.player.vel.update(move * self.player.speed)
+        span = self.tracer.span
+        with span("_read_move"):
+            if self.autopilot is not None:
+                move = self.autopilot.read_move(self, dt)
+            else:
+                move = self._read_move()
+        vel = self.player.vel
+        vel.update(move)
+        vel *= self.player.speed
 
         # Axis-separated movement against solid walls
-        self._move_player_axis("x", self.player.vel.x * dt)
-        self._move_player_axis("y", self.player.vel.y * dt)
+        with span("_move_player_axis"):
+            self._move_player_axis("x", self.player.vel.x * dt)
+            self._move_player_axis("y", self.player.vel.y * dt)
+        if self.telemetry is not None:
+            self.telemetry.visit(self.player.rect.center, dt)
 
         # Triggers: coin pickup
-        picked = pygame.sprite.spritecollide(self.player, self.coins, dokill=True)
+        with span("triggers"):
+            picked = self._touching(self.coin_boxes, self.coin_index, ecs.PICKUP)
         if picked:
+            for coin in picked:
+                if self.telemetry is not None:
+                    self.telemetry.event(COINS, coin.rect.center)
+                self.particles.emit(COIN, coin.rect.center, 14)
+                coin.kill()
+                self.coin_index.remove(coin)
+                if self.coin_boxes is not None:
+                    self.coin_boxes.remove(coin)
             self.player.score += len(picked)
             if not self.muted:
                 self.coin_sfx.play()
             self._check_goal()
 
         # Hazards: damage + response
-        for hz in pygame.sprite.spritecollide(self.player, self.hazards, dokill=False):
+        with span("triggers"):
+            hurt = self._touching(self.hazard_boxes, self.hazard_index, ecs.DAMAGE)
+        for hz in hurt:
             self._apply_damage(hz.rect)
 
-        self.hazards.update(dt)
+        if self.streamer is not None:
+            self.streamer.update(self.player.rect.center)
+        self.camera.follow(self.player.rect.center, dt)
+        with span("hazards.update"):
+            self.activity.update(
+                self.hazards, dt, focus=self.player.rect, viewport=self.camera.view, world=self.entities
+            )
 
         if self.player.invincible_for > 0:
             self.player.invincible_for = max(0.0, self.player.invincible_for - dt)
 
-        for goal in pygame.sprite.spritecollide(self.player, self.goals, dokill=False):
+        with span("triggers"):
+            reached = self._touching(self.goal_boxes, self.goal_index, ecs.REACH)
+        for goal in reached:
             if not goal.locked:
                 if not self.muted:
                     self.victory_sfx.play()
                 self.state = "win"
 
-    def _camera_offset(self) -> pygame.Vector2:
+    def seek_hazards(self, t: float) -> None:
+        """Jump every hazard to its patrol position t seconds after level start."""
+        self.activity.reset(t)
+        for hz in self.hazards:
+            hz.seek(t)
+
+    def _camera_offset(self) -> tuple[float, float]:
         if self._shake <= 0:
-            return pygame.Vector2(0, 0)
+            return _NO_SHAKE
 
         strength = 9.0 * (self._shake / 0.18)
-        return pygame.Vector2(
-            random.uniform(-strength, strength),
-            random.uniform(-strength, strength),
+        return (
+            self.rng.uniform(-strength, strength),
+            self.rng.uniform(-strength, strength),
         )
 
     def draw(self) -> None:
-        self.screen.fill(self.palette.bg)
-
-        pygame.draw.rect(self.screen, self.palette.panel, pygame.Rect(0, 0, self.SCREEN_W, self.HUD_H))
-        pygame.draw.line(
-            self.screen,
-            pygame.Color("#000000"),
-            (0, self.HUD_H),
-            (self.SCREEN_W, self.HUD_H),
-            1,
-        )
-
-        hud = f"Coins Collected: {self.player.score}    HP: {self.player.hp}"
-        if self.player.is_invincible:
-            hud += "    i-frames"
-        if self.muted:
-             hud += "    [MUTED]"
+        self.render(self.snapshot())
+
+    def snapshot(self, input_time: float = 0.0) -> FrameSnapshot:
+        """Capture what this frame shows as plain values (see pipeline.FrameSnapshot)."""
+        player = self.player
+        key = (player.score, player.hp, player.is_invincible, self.muted)
+        if key != self._hud_key:
+            self._hud_key = key
+            hud = f"Coins Collected: {player.score}    HP: {player.hp}"
+            if player.is_invincible:
+                hud += "    i-frames"
+            if self.muted:
+                hud += "    [MUTED]"
+            self._hud_want = hud
+        if self._hud_want != self._hud and self._hud_age >= self.quality.hud_interval:
+            self._hud, self._hud_age = self._hud_want, 0.0
+
+        shake = self._camera_offset()
+        # World -> screen; shake is applied to the finished world layer, not here
+        cam = self.camera.offset
+
+        # Only touch what intersects the view (padding and shake included)
+        view = self._view
+        view.update(self.camera.view)
+        view.inflate_ip(2 * (self.PADDING + 10), 2 * (self.PADDING + 10))
+        # Queried in layer order: coins, hazards, goals
+        coins = self.coin_index.query(view, self._coins)
+        hazards = self.hazard_index.query(view, self._hazards)
+        goals = self.goal_index.query(view, self._goals)
+
+        # Visible sprites as (look, x, y), bottom layer first
+        sprites = self._sprites
+        sprites.clear()
+        if self.entities is not None:
+            # Render system straight off the columns; no per-row sprite objects
+            eids = self._eids
+            eids.clear()
+            for group in (coins, hazards, goals):
+                for s in group:
+                    eids.append(s.entity)
+            ecs.sprites(self.entities, eids, sprites)
+        else:
+            for group in (coins, hazards, goals):
+                for s in group:
+                    sprites.append(s.art)
+        sprites.append(player.art)
 
-        self.screen.blit(self.font.render(hud, True, self.palette.text), (14, 18))
-        self.screen.blit(
-            self.font.render("WASD/Arrows move • F1 debug • R reset • Esc quit", True, self.palette.subtle),
-            (14, 36),
+        debug_boxes: tuple = ()
+        debug_text = None
+        if self.debug:
+            debug_boxes = (
+                ((tuple(self.player.rect), pygame.Color("#8fbcbb")),)
+                + tuple((tuple(g.rect), pygame.Color("#4b1a8b")) for g in goals)
+                + tuple((tuple(c.rect), pygame.Color("#ebcb8b")) for c in coins)
+                + tuple((tuple(h.rect), pygame.Color("#bf616a")) for h in hazards)
+            )
+            debug_text = f"Active hazards: {len(self.activity.active)}/{len(self.hazards)}"
+            mb = 1024 * 1024
+            debug_text += f"  Tiles: {self.tiles.bytes_used / mb:.0f}/{self.tiles.budget_bytes / mb:.0f} MB"
+            if self.quality is not TIERS[0]:
+                debug_text += f"  Q: {self.quality.name}"
+            if self.gc_policy is not None:
+                # Last and worst collector pause so far
+                debug_text += f"  GC: {self.gc_policy.last_ms:.1f}/{self.gc_policy.max_ms:.1f} ms"
+            if self.capture is not None and self.capture.dropped:
+                debug_text += f"  Cap drop: {self.capture.dropped}"
+
+        return FrameSnapshot(
+            input_time=input_time,
+            state=self.state,
+            hud=self._hud,
+            shake=shake,
+            cam=cam,
+            view=tuple(view),
+            tiles=self.tiles,
+            sprites=tuple(sprites),
+            particles=self.particles.visible(self.camera.view),
+            debug_boxes=debug_boxes,
+            debug_text=debug_text,
         )
 
-        cam = self._camera_offset()
-
-        # Draw walls
-        for wall in self.walls:
-            pygame.draw.rect(self.screen, wall.color, wall.rect.move(cam))
-
-        # Draw coins (bigger art than hitbox)
-        for coin in self.coins:
-            visual = pygame.Rect(0, 0, coin.visual_size, coin.visual_size)
-            visual.center = coin.rect.center
-            pygame.draw.circle(self.screen, coin.color, visual.center + cam, visual.width // 2)
-            pygame.draw.circle(self.screen, pygame.Color("#000000"), visual.center + cam, visual.width // 2, 2)
-
-        # Draw hazards
-        for hazard in self.hazards:
-            r = hazard.rect.move(cam)
-            pts = [(r.centerx, r.top), (r.right, r.bottom), (r.left, r.bottom)]
-            pygame.draw.polygon(self.screen, hazard.color, pts)
-            pygame.draw.polygon(self.screen, pygame.Color("#000000"), pts, 2)
-
-        # Draw Goal
-        for goal in self.goals:
-            visual = pygame.Rect(0, 0, goal.visual_size, goal.visual_size)
-            visual.center = goal.rect.center
-            color = goal.color if not goal.locked else goal.locked_color
-            pygame.draw.rect(self.screen, color, goal.rect.move(cam))
-            pygame.draw.rect(self.screen, pygame.Color("#000000"), goal.rect.move(cam), 2)
-            
-
-        # Draw player (bigger art than hitbox)
-        pr = self.player.rect.move(cam)
-        visual = pygame.Rect(0, 0, self.player.visual_size, self.player.visual_size)
-        visual.center = pr.center
-        player_color = self.player.color
-        if self.player.is_invincible:
-            # Simple blink while invincible
-            if int(self.player.invincible_for * 16) % 2 == 0:
-                player_color = pygame.Color("#d8dee9")
-        pygame.draw.circle(self.screen, player_color, visual.center, visual.width // 2)
-        pygame.draw.circle(self.screen, pygame.Color("#000000"), visual.center, visual.width // 2, 2)
+    def render(self, snap: FrameSnapshot) -> None:
+        """Draw a snapshot to the canvas.
+
+        Besides the snapshot, this reads render-side state (canvas, fonts, art,
+        quality) that only present() changes, so it belongs on the thread that
+        presents.
+        """
+        c = self.canvas
+        q = self.quality
+        screen = c.surface
+        screen.fill(self.palette.bg)
+
+        pygame.draw.rect(screen, self.palette.panel, self._panel_rect)
+        start, end, width = self._rule
+        pygame.draw.line(screen, _BLACK, start, end, width)
+
+        screen.blit(self._text(self.font, snap.hud, self.palette.text), self._hud_at)
+        screen.blit(
+            self._text(self.font, "WASD/Arrows move • F1 debug • R reset • Esc quit", self.palette.subtle),
+            self._hint_at,
+        )
+        # Draw calls this frame, counting a batched blits() as one
+        calls = 5
+
+        if snap.debug_text is not None:
+            self._draw_debug_text(snap)
+            calls += 2
+
+        clip = self._clip
+        # Shake moves the finished world as a whole, so it costs one blit however much is on screen
+        shift = c.point(snap.shake)
+        world = screen
+        if shift != (0, 0):
+            world = self._world_layer(screen)
+        world.set_clip(clip)
+        if world is not screen:
+            world.fill(self.palette.bg)
+        calls += self._draw_world(world, snap)
+        world.set_clip(None)
+        if world is not screen:
+            screen.set_clip(clip)
+            screen.blit(world, clip.move(shift), clip)
+            screen.set_clip(None)
+            calls += 2
+
+        message = self.CENTER_MESSAGES.get(snap.state)
+        if message is not None:
+            calls += self._draw_center_message(message, shift, overlay=q.overlays)
+        self.draw_calls = calls
+
+    def _world_layer(self, screen: pygame.Surface) -> pygame.Surface:
+        # Offscreen copy of the screen's layout, for drawing the world steady while it shakes
+        if self._layer is None or self._layer.get_size() != screen.get_size():
+            self._layer = pygame.Surface(screen.get_size(), 0, screen)
+        return self._layer
+
+    def _draw_world(self, target: pygame.Surface, snap: FrameSnapshot) -> int:
+        """Tiles, then every sprite in one batched blit, then debug hitboxes; returns the draw calls made."""
+        c = self.canvas
+        ox, oy = snap.cam
+
+        # Draw walls (pre-rendered background tiles, a few blits)
+        view = self._render_view
+        view.update(snap.view)
+        calls = snap.tiles.draw(target, view, snap.cam)
+
+        # Coins, hazards, goals and the player, bottom layer first
+        place, outline = self.art.place, self.quality.outlines
+        items = self._blit_items
+        items.clear()
+        for look, x, y in snap.sprites:
+            items.append(place(look, x + ox, y + oy, outline))
+        target.blits(items, doreturn=False)
+        items.clear()
+        calls += 1
+
+        # Particles over the sprites, one more batched blit
+        xy, dot = snap.particles
+        if len(xy):
+            image = self.art.image
+            images = [image(key, False)[0] for key in self.dot_keys()]
+            target.blits(zip(map(images.__getitem__, dot.tolist()), self.dot_positions(snap)), doreturn=False)
+            calls += 1
+
+        if snap.debug_text is not None:
+            # Hitboxes (visible ones only)
+            for box, color in snap.debug_boxes:
+                pygame.draw.rect(target, color, c.rect(pygame.Rect(box).move(ox, oy)), c.width(2))
+            calls += len(snap.debug_boxes)
+        return calls
+
+    def dot_keys(self) -> list[tuple]:
+        """Art keys of DOT_LOOKS at the current render scale, indexed like snapshot dots."""
+        # Their anchor offsets are cached alongside for dot_positions
+        art = self.art
+        if self._dot_scale != art.scale:
+            self._dot_keys = [art.key(look, 0, 0)[0] for look in DOT_LOOKS]
+            self._dot_offsets[:] = [art.image(key, False)[1:] for key in self._dot_keys]
+            self._dot_scale = art.scale
+        return self._dot_keys
+
+    def dot_positions(self, snap: FrameSnapshot) -> list[list[int]]:
+        """Internal-pixel blit positions of the snapshot's particle dots (no shake), all at once."""
+        xy, dot = snap.particles
+        self.dot_keys()
+        pos = xy + snap.cam
+        k = self.art.scale
+        if k != 1:
+            # Same rounding as ArtCache.key's round(x * k)
+            pos = np.rint(pos * k).astype(np.int32)
+        return (pos + self._dot_offsets[dot]).tolist()
+
+    def present(self, snap: FrameSnapshot) -> None:
+        """Render a snapshot with the selected backend and show it."""
+        span = self.tracer.span
+        wanted = self._wanted_quality
+        if wanted is not None:
+            # Frame boundary: nothing is drawing with the old canvas or art
+            self._wanted_quality = None
+            self.set_quality(wanted)
+        if self.backend is not None:
+            with span("draw"):
+                self.backend.render(snap)
+            if self.capture is not None:
+                with span("capture"):
+                    self.capture.grab(self._read_frame)
+            with span("display.flip"):
+                self.backend.present()
+        else:
+            with span("draw"):
+                self.render(snap)
+            if self.capture is not None:
+                with span("capture"):
+                    self.capture.grab(self._read_frame)
+            with span("display.flip"):
+                self.canvas.present()
+
+    def _read_frame(self, into: pygame.Surface) -> None:
+        """Copy the frame just rendered (internal resolution) into a capture surface."""
+        size = into.get_size()
+        if self.backend is not None:
+            if size == self.canvas.size:
+                self.backend.read_into(into)
+            else:
+                # Render scale changed since capture started (governor); rare, so the slow path
+                pygame.transform.scale(self.backend.to_surface(), size, into)
+        elif size == self.canvas.size:
+            into.blit(self.canvas.surface, (0, 0))
+        else:
+            pygame.transform.scale(self.canvas.surface, size, into)
 
-        if self.debug:
-            self._draw_debug(cam)
-
-        if self.state == "title":
-            self._draw_center_message("Sprites + Collisions\nCollect all coins to unlock Goal and win!\nPress Space to start", cam)
-        elif self.state == "gameover":
-            self._draw_center_message("Game over\nPress Space to restart", cam)
-        elif self.state == "win":
-            self._draw_center_message("You Win!\nPress Space to play again", cam)
-
-    def _draw_debug(self, cam: pygame.Vector2) -> None:
-        # Hitboxes
-        pygame.draw.rect(self.screen, pygame.Color("#8fbcbb"), self.player.rect.move(cam), 2)
-        for goal in self.goals:
-            pygame.draw.rect(self.screen, pygame.Color("#4b1a8b"), goal.rect.move(cam), 2)
-        for coin in self.coins:
-            pygame.draw.rect(self.screen, pygame.Color("#ebcb8b"), coin.rect.move(cam), 2)
-        for hazard in self.hazards:
-            pygame.draw.rect(self.screen, pygame.Color("#bf616a"), hazard.rect.move(cam), 2)
-        
-        # Help text
+    def _draw_debug_text(self, snap: FrameSnapshot) -> None:
+        c = self.canvas
         self.screen.blit(
-            self.font.render("DEBUG: Rect hitboxes (collisions use these)", True, self.palette.text),
-            (self.SCREEN_W - 320, 18),
+            self._text(self.font, "DEBUG: Rect hitboxes (collisions use these)", self.palette.text),
+            c.point((self.SCREEN_W - 320, 18)),
         )
-
-    def _draw_center_message(self, message: str, cam: pygame.Vector2) -> None:
+        # Draw calls are the previous frame's; this one is still being drawn
+        surf = self._text(self.font, f"{snap.debug_text}  Draws: {self.draw_calls}", self.palette.subtle)
+        # Slides left rather than off the edge when the stats run long
+        x = min(c.px(self.SCREEN_W - 320), c.px(self.SCREEN_W - 8) - surf.get_width())
+        self.screen.blit(surf, (x, c.px(36)))
+
+    def _draw_center_message(self, message: str, shift: tuple[int, int], *, overlay: bool = True) -> int:
+        # Shaken by the same offset as the world layer underneath
+        c = self.canvas
+        sx, sy = shift
         lines = message.split("\n")
         total_h = len(lines) * 44
         y = self.playfield.centery - total_h // 2
 
-        overlay = pygame.Surface((self.playfield.width, self.playfield.height), pygame.SRCALPHA)
-        overlay.fill((0, 0, 0, 150))
-        self.screen.blit(overlay, self.playfield.topleft + cam)
+        if overlay:
+            panel = self._overlay
+            if panel is None:
+                panel = self._overlay = pygame.Surface(self._overlay_at.size, pygame.SRCALPHA)
+                panel.fill((0, 0, 0, 150))
+            self.screen.blit(panel, (self._overlay_at.x + sx, self._overlay_at.y + sy))
 
         for line in lines:
-            surf = self.big_font.render(line, True, self.palette.text)
-            x = self.playfield.centerx - surf.get_width() // 2
-            self.screen.blit(surf, (x, y) + cam)
+            surf = self._text(self.big_font, line, self.palette.text)
+            x = c.px(self.playfield.centerx) - surf.get_width() // 2
+            self.screen.blit(surf, (x + sx, c.px(y) + sy))
             y += 44
+        return len(lines) + (1 if overlay else 0)
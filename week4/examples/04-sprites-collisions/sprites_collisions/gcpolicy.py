@@ -0,0 +1,113 @@
+"""Cyclic GC control: collect in the frame's slack instead of wherever an allocation trips it."""
+
+from __future__ import annotations
+
+import gc
+import time
+
+
+class GcPolicy:
+    """Measures every cyclic GC pause and, in "idle" mode, decides when they happen.
+
+    "auto" leaves Python's collector alone and only times it.
+
+    "idle" turns automatic collection off. After each level load it runs one
+    full collection and freezes what survives (gc.freeze), so walls, sprites
+    and caches never get scanned again. During play the loop calls idle()
+    with the time the next frame starts. Whichever generation Python would
+    have collected by now runs there, if its last duration fits before the
+    deadline. A frame with no slack only forces a collection once the
+    young generation is `force_factor` times over its threshold, so
+    garbage cannot pile up without bound.
+
+    Pauses inside idle() or a level load are "scheduled"; any other pause
+    hit the middle of a frame and is counted as in-frame.
+    """
+
+    def __init__(self, mode: str = "auto", *, margin_ms: float = 1.0, force_factor: int = 8) -> None:
+        if mode not in ("auto", "idle"):
+            raise ValueError(f"unknown GC mode {mode!r}")
+        self.mode = mode
+        self.margin = margin_ms / 1000.0
+        self.force_factor = force_factor
+
+        self.count = 0
+        self.total_ms = 0.0
+        self.last_ms = 0.0
+        self.max_ms = 0.0
+        self.in_frame = 0
+        self.in_frame_max_ms = 0.0
+        # Last duration of a collection per generation, to judge whether the next one fits
+        self._cost = [0.0, 0.0, 0.0]
+        self._scheduled = False
+        self._started = 0.0
+
+        gc.callbacks.append(self._on_gc)
+        if mode == "idle":
+            gc.disable()
+
+    def close(self) -> None:
+        """Hand the collector back to Python."""
+        if self._on_gc in gc.callbacks:
+            gc.callbacks.remove(self._on_gc)
+        if self.mode == "idle":
+            gc.unfreeze()
+            gc.enable()
+
+    def _on_gc(self, phase: str, info: dict) -> None:
+        if phase == "start":
+            self._started = time.perf_counter()
+            return
+        seconds = time.perf_counter() - self._started
+        ms = seconds * 1000.0
+        self._cost[info["generation"]] = seconds
+        self.count += 1
+        self.total_ms += ms
+        self.last_ms = ms
+        self.max_ms = max(self.max_ms, ms)
+        if not self._scheduled:
+            self.in_frame += 1
+            self.in_frame_max_ms = max(self.in_frame_max_ms, ms)
+
+    def _collect(self, generation: int) -> None:
+        self._scheduled = True
+        try:
+            gc.collect(generation)
+        finally:
+            self._scheduled = False
+
+    def level_loaded(self) -> None:
+        """Collect the previous level's cycles, then freeze everything that is left."""
+        if self.mode != "idle":
+            return
+        # Last level's sprites were frozen too; they are garbage now (sprite <-> group cycles)
+        gc.unfreeze()
+        self._collect(2)
+        gc.freeze()
+
+    def idle(self, deadline: float) -> None:
+        """Run whatever collection is due if it fits before `deadline` (a perf_counter time)."""
+        if self.mode != "idle":
+            return
+        c0, c1, c2 = gc.get_count()
+        t0, t1, t2 = gc.get_threshold()
+        # Same order the automatic collector would pick; an older one also sweeps the younger
+        due = [gen for gen, (c, t) in enumerate(((c0, t0), (c1, t1), (c2, t2))) if c >= t]
+        if not due:
+            return
+        left = deadline - self.margin - time.perf_counter()
+        for gen in reversed(due):
+            if self._cost[gen] <= left:
+                self._collect(gen)
+                return
+        if c0 >= self.force_factor * t0:
+            # No slack for a while; the young generation is the cheapest way to keep up
+            self._collect(0)
+
+    def summary(self) -> dict[str, float]:
+        return {
+            "gc_count": self.count,
+            "gc_max_ms": self.max_ms,
+            "gc_in_frame": self.in_frame,
+            "gc_in_frame_max_ms": self.in_frame_max_ms,
+        }
@@ -0,0 +1,223 @@
+"""Golden-image checks for the render path. Run from the example folder:
+
+    python3 -m sprites_collisions.golden            # compare against golden/
+    python3 -m sprites_collisions.golden --update   # re-record the goldens
+
+Every case builds a fixed game state (seeded level, autopilot and shake)
+and renders it with Game.draw under the dummy video driver. The frame is
+hashed and compared with golden/manifest.json; only a mismatch loads the
+stored PNG for a per-pixel diff, written to golden/_diff/<case>.png.
+Cases render in parallel worker processes.
+
+Text goes through whatever font pygame finds. Goldens recorded on one machine
+may differ on another in the HUD alone, so record them on the machine type that
+runs the check.
+"""
+
+from __future__ import annotations
+
+import argparse
+import functools
+import hashlib
+import json
+import multiprocessing
+import os
+import sys
+from concurrent.futures import ProcessPoolExecutor
+from pathlib import Path
+from typing import Callable
+
+os.environ.setdefault("SDL_VIDEODRIVER", "dummy")
+os.environ.setdefault("SDL_AUDIODRIVER", "dummy")
+
+import numpy as np  # noqa: E402
+import pygame  # noqa: E402
+
+from . import levels  # noqa: E402
+
+GOLDEN = Path(__file__).resolve().parent.parent / "golden"
+
+
+def _press(game, key: int) -> None:
+    game.handle_event(pygame.event.Event(pygame.KEYDOWN, key=key))
+
+
+def _play(game, frames: int = 1, *, bot: bool = False) -> None:
+    from .autoplay import AutoPilot
+
+    _press(game, pygame.K_SPACE)
+    if bot:
+        game.autopilot = AutoPilot(seed=0)
+    for _ in range(frames):
+        game.update(1 / 60)
+
+
+def _hurt(game) -> None:
+    _play(game, 10)
+    game.player.hp -= 1
+    game.player.invincible_for = 0.5
+    game._shake = 0.12
+
+
+def _ended(state: str, game) -> None:
+    _play(game, 30, bot=True)
+    game.state = state
+
+
+def _quality(tier: int, game) -> None:
+    from .quality import TIERS
+
+    _play(game, 60, bot=True)
+    game.set_quality(TIERS[tier])
+
+
+def _debug(game) -> None:
+    _play(game, 90, bot=True)
+    game.debug = True
+
+
+def _bursts(game) -> None:
+    from .particles import KINDS
+
+    _play(game, 10)
+    x, y = game.player.rect.center
+    for kind in range(len(KINDS)):
+        game.particles.emit(kind, (x + 90 * kind, y - 30), 40)
+    for _ in range(12):
+        game.update(1 / 60)
+
+
+def _muted(game) -> None:
+    _play(game, 1)
+    _press(game, pygame.K_m)
+
+
+# name -> (Game keyword arguments, what to do before the frame is drawn)
+CASES: dict[str, tuple[dict, Callable]] = {
+    "title": ({}, lambda game: None),
+    "play": ({}, _play),
+    "autoplay": ({}, functools.partial(_play, frames=240, bot=True)),
+    "debug": ({}, _debug),
+    "muted": ({}, _muted),
+    "hurt_shake": ({}, _hurt),
+    "gameover": ({}, functools.partial(_ended, "gameover")),
+    "win": ({}, functools.partial(_ended, "win")),
+    "quality_flat": ({}, functools.partial(_quality, 1)),
+    "quality_min": ({}, functools.partial(_quality, 4)),
+    "half_scale": ({"render_scale": 0.5}, functools.partial(_play, frames=120, bot=True)),
+    "particles": ({"render_scale": 0.5}, _bursts),
+    "ecs": ({"use_ecs": True}, functools.partial(_play, frames=240, bot=True)),
+    "tiled_scroll": (
+        {"level": functools.partial(levels.tiled, cols=3, rows=2)},
+        functools.partial(_play, frames=400, bot=True),
+    ),
+    "generated": (
+        {"level": functools.partial(levels.generated, walls=300, coins=60, hazards=30, seed=3)},
+        functools.partial(_play, frames=180, bot=True),
+    ),
+}
+
+
+def _init_worker() -> None:
+    pygame.init()
+    pygame.mixer.init()
+
+
+def render_case(name: str) -> tuple[str, tuple[int, int], bytes]:
+    """Build the case's state and draw one frame; returns its RGB pixels."""
+    from .game import Game
+
+    options, setup = CASES[name]
+    game = Game(seed=0, **options)
+    setup(game)
+    # Same frame every run: shake offsets come from game.rng, and every visible tile is ready
+    game.rng.seed(0)
+    game.tiles.warm(game.camera.view)
+    game.draw()
+    surface = game.canvas.surface
+    pixels = pygame.image.tobytes(surface, "RGB")
+    game.tiles.close()
+    return name, surface.get_size(), pixels
+
+
+def _digest(pixels: bytes) -> str:
+    return hashlib.sha1(pixels).hexdigest()
+
+
+def _diff(name: str, size: tuple[int, int], pixels: bytes, golden: Path, tolerance: int) -> dict:
+    """Per-pixel comparison with the stored PNG; writes a diff image when anything is off."""
+    w, h = size
+    stored = pygame.image.load(golden / f"{name}.png")
+    if stored.get_size() != size:
+        return {"pixels": w * h, "max_delta": 255, "box": None, "note": f"size {stored.get_size()} -> {size}"}
+    a = np.frombuffer(pygame.image.tobytes(stored, "RGB"), np.uint8).reshape(h, w, 3).astype(np.int16)
+    b = np.frombuffer(pixels, np.uint8).reshape(h, w, 3).astype(np.int16)
+    delta = np.abs(a - b).max(axis=2)
+    off = delta > tolerance
+    count = int(off.sum())
+    result = {"pixels": count, "max_delta": int(delta.max()), "box": None}
+    if count:
+        ys, xs = np.nonzero(off)
+        result["box"] = (int(xs.min()), int(ys.min()), int(xs.max() - xs.min() + 1), int(ys.max() - ys.min() + 1))
+        # Dimmed current frame with the differing pixels in red
+        out = (b // 3).astype(np.uint8)
+        out[off] = (255, 0, 0)
+        (golden / "_diff").mkdir(exist_ok=True)
+        pygame.image.save(pygame.image.frombuffer(out.tobytes(), size, "RGB"), golden / "_diff" / f"{name}.png")
+    return result
+
+
+def main() -> int:
+    parser = argparse.ArgumentParser(prog="python3 -m sprites_collisions.golden")
+    parser.add_argument("--cases", nargs="+", choices=tuple(CASES), default=list(CASES))
+    parser.add_argument("--update", action="store_true", help="record the rendered frames as the new goldens")
+    parser.add_argument("--jobs", type=int, default=os.cpu_count() or 1, help="worker processes")
+    parser.add_argument("--tolerance", type=int, default=0, help="per-channel difference still counted as equal")
+    parser.add_argument("--max-pixels", type=int, default=0, help="differing pixels a case may have and still pass")
+    parser.add_argument("--golden", default=str(GOLDEN))
+    args = parser.parse_args()
+
+    golden = Path(args.golden)
+    manifest_path = golden / "manifest.json"
+    manifest = json.loads(manifest_path.read_text()) if manifest_path.exists() else {}
+
+    # spawn: each worker brings up its own SDL instead of inheriting half of ours
+    context = multiprocessing.get_context("spawn")
+    with ProcessPoolExecutor(max_workers=max(1, args.jobs), mp_context=context, initializer=_init_worker) as pool:
+        frames = list(pool.map(render_case, args.cases))
+
+    if args.update:
+        golden.mkdir(parents=True, exist_ok=True)
+        pygame.init()
+        for name, size, pixels in frames:
+            pygame.image.save(pygame.image.frombuffer(pixels, size, "RGB"), golden / f"{name}.png")
+            manifest[name] = {"size": list(size), "sha1": _digest(pixels)}
+        manifest_path.write_text(json.dumps(manifest, indent=2, sort_keys=True) + "\n")
+        print(f"recorded {len(frames)} goldens in {golden}")
+        return 0
+
+    failed = 0
+    print(f"{'case':<14}{'result':<8}{'pixels':>9}{'max delta':>11}  where")
+    for name, size, pixels in frames:
+        entry = manifest.get(name)
+        if entry is None:
+            print(f"{name:<14}{'new':<8}")
+            failed += 1
+            continue
+        if entry["size"] == list(size) and entry["sha1"] == _digest(pixels):
+            print(f"{name:<14}{'ok':<8}{0:>9}{0:>11}")
+            continue
+        d = _diff(name, size, pixels, golden, args.tolerance)
+        ok = d["pixels"] <= args.max_pixels
+        failed += not ok
+        where = d.get("note") or (f"x,y,w,h={d['box']}" if d["box"] else "within tolerance")
+        print(f"{name:<14}{'ok~' if ok else 'DIFF':<8}{d['pixels']:>9}{d['max_delta']:>11}  {where}")
+    if failed:
+        print(f"{failed} case(s) failed; diff images in {golden / '_diff'}")
+    else:
+        print(f"all {len(frames)} cases match")
+    return 1 if failed else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
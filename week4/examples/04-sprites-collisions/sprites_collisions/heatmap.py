@@ -0,0 +1,185 @@
+"""Where players spend time, take damage and pick up coins, binned per layout.
+
+    python3 main.py --headless --autoplay --duration 600 --heatmap runs/run-001
+    python3 -m sprites_collisions.heatmap merge merged/ runs/*.npz
+    python3 -m sprites_collisions.heatmap render merged/arena.npz
+
+A session writes STEM.npz (the raw grids) and STEM.png (a rendered view).
+`merge` sums any number of .npz files in one pass, one output per layout.
+"""
+
+from __future__ import annotations
+
+import argparse
+import math
+import sys
+from pathlib import Path
+from typing import Iterable
+
+import numpy as np
+import pygame
+
+LAYERS = ("time", "damage", "coins")
+TIME, DAMAGE, COINS = range(3)
+
+# Cells along the world's longer side at most, so huge levels keep a small fixed grid
+MAX_BINS = 256
+MIN_CELL = 8
+
+# Heat ramp: black -> purple -> orange -> pale yellow
+_RAMP_AT = (0.0, 0.35, 0.7, 1.0)
+_RAMP_RGB = ((12, 12, 20), (110, 30, 120), (235, 110, 40), (255, 240, 170))
+
+
+class Heatmap:
+    """Fixed grid of (time, damage, coins) over one layout's world rect.
+
+    visit() and event() index one cell each, so a frame costs the same on
+    any grid size or layout. The grid shape comes from the world size alone.
+    Runs of the same layout therefore line up cell for cell and merge by
+    addition.
+    """
+
+    def __init__(
+        self,
+        layout: str,
+        world: pygame.Rect | tuple[int, int, int, int],
+        *,
+        walls: Iterable[tuple[int, int, int, int]] = (),
+    ) -> None:
+        self.layout = layout
+        self.bounds = tuple(int(v) for v in world)
+        x, y, w, h = self.bounds
+        self.cell = max(MIN_CELL, math.ceil(max(w, h) / MAX_BINS))
+        self.cols = max(1, math.ceil(w / self.cell))
+        self.rows = max(1, math.ceil(h / self.cell))
+        self.grid = np.zeros((len(LAYERS), self.rows, self.cols), np.float64)
+        self.walls = np.array(list(walls), np.int32).reshape(-1, 4)
+        self.runs = 1
+        # Per-layer views, so the hot path indexes a 2-D array directly
+        self._layers = tuple(self.grid[i] for i in range(len(LAYERS)))
+
+    def _cell(self, pos: tuple[int, int]) -> tuple[int, int]:
+        x, y, _, _ = self.bounds
+        col = min(max((pos[0] - x) // self.cell, 0), self.cols - 1)
+        row = min(max((pos[1] - y) // self.cell, 0), self.rows - 1)
+        return row, col
+
+    def visit(self, pos: tuple[int, int], dt: float) -> None:
+        """The player spent dt seconds at pos."""
+        self._layers[TIME][self._cell(pos)] += dt
+
+    def event(self, layer: int, pos: tuple[int, int]) -> None:
+        """Count one DAMAGE or COINS event at pos."""
+        self._layers[layer][self._cell(pos)] += 1
+
+    def add(self, other: Heatmap) -> None:
+        if (other.bounds, other.cell, other.grid.shape) != (self.bounds, self.cell, self.grid.shape):
+            raise ValueError(f"layout {other.layout!r}: grid {other.bounds}/{other.cell} does not match {self.bounds}/{self.cell}")
+        self.grid += other.grid
+        self.runs += other.runs
+        if not len(self.walls):
+            self.walls = other.walls
+
+    # Files
+
+    def save(self, stem: str | Path) -> tuple[Path, Path]:
+        """Write STEM.npz and STEM.png."""
+        stem = Path(stem)
+        stem.parent.mkdir(parents=True, exist_ok=True)
+        npz = stem.with_name(stem.name + ".npz")
+        np.savez_compressed(
+            npz,
+            grid=self.grid,
+            layers=np.array(LAYERS),
+            layout=np.array(self.layout),
+            bounds=np.array(self.bounds, np.int64),
+            cell=np.array(self.cell),
+            runs=np.array(self.runs),
+            walls=self.walls,
+        )
+        png = stem.with_name(stem.name + ".png")
+        self.render(png)
+        return npz, png
+
+    @classmethod
+    def load(cls, path: str | Path) -> Heatmap:
+        with np.load(path) as data:
+            heat = cls(str(data["layout"]), tuple(data["bounds"]))
+            if int(data["cell"]) != heat.cell or data["grid"].shape != heat.grid.shape:
+                raise ValueError(f"{path}: grid was written with different binning")
+            heat.grid[...] = data["grid"]
+            heat.runs = int(data["runs"])
+            heat.walls = data["walls"]
+        return heat
+
+    def render(self, path: str | Path, *, width: int = 960) -> None:
+        """One panel per layer, stacked, log-scaled, with walls outlined for orientation."""
+        scale = max(1, width // self.cols)
+        pw, ph = self.cols * scale, self.rows * scale
+        title_h = 22
+        image = pygame.Surface((pw, (ph + title_h) * len(LAYERS)))
+        image.fill((0, 0, 0))
+        pygame.font.init()
+        font = pygame.font.Font(None, 20)
+        x0, y0, _, _ = self.bounds
+        k = scale / self.cell
+        for i, name in enumerate(LAYERS):
+            layer = self.grid[i]
+            peak = float(layer.max())
+            norm = np.log1p(layer) / math.log1p(peak) if peak > 0 else layer
+            rgb = np.stack([np.interp(norm, _RAMP_AT, [c[ch] for c in _RAMP_RGB]) for ch in range(3)], axis=-1)
+            # surfarray is (x, y); grid is (row, col)
+            panel = pygame.surfarray.make_surface(rgb.astype(np.uint8).transpose(1, 0, 2))
+            top = i * (ph + title_h)
+            image.blit(pygame.transform.scale(panel, (pw, ph)), (0, top + title_h))
+            for wx, wy, ww, wh in self.walls:
+                rect = (round((wx - x0) * k), top + title_h + round((wy - y0) * k), max(1, round(ww * k)), max(1, round(wh * k)))
+                pygame.draw.rect(image, (90, 100, 120), rect, 1)
+            total = f"{layer.sum():.0f} s" if i == TIME else f"{layer.sum():.0f}"
+            label = f"{self.layout} - {name} (total {total}, peak cell {peak:.4g}, {self.runs} run(s))"
+            image.blit(font.render(label, True, (220, 220, 220)), (6, top + 4))
+        pygame.image.save(image, str(path))
+
+
+def merge(paths: Iterable[str | Path]) -> dict[str, Heatmap]:
+    """Sum .npz files per layout in one pass; only one accumulator per layout is kept in memory."""
+    merged: dict[str, Heatmap] = {}
+    for path in paths:
+        heat = Heatmap.load(path)
+        acc = merged.get(heat.layout)
+        if acc is None:
+            merged[heat.layout] = heat
+        else:
+            acc.add(heat)
+    return merged
+
+
+def main() -> int:
+    parser = argparse.ArgumentParser(prog="python3 -m sprites_collisions.heatmap")
+    sub = parser.add_subparsers(dest="command", required=True)
+    m = sub.add_parser("merge", help="sum session .npz files, one LAYOUT.npz/.png per layout")
+    m.add_argument("out_dir")
+    m.add_argument("files", nargs="+")
+    r = sub.add_parser("render", help="draw an .npz as a PNG next to it (or at --png)")
+    r.add_argument("file")
+    r.add_argument("--png", default=None)
+    args = parser.parse_args()
+
+    if args.command == "merge":
+        out = Path(args.out_dir)
+        for layout, heat in merge(args.files).items():
+            safe = "".join(c if c.isalnum() or c in "-_." else "_" for c in layout)
+            npz, png = heat.save(out / safe)
+            print(f"{layout}: {heat.runs} runs, {heat.grid[TIME].sum():.0f} s -> {npz}, {png}")
+        return 0
+
+    heat = Heatmap.load(args.file)
+    png = args.png or str(Path(args.file).with_suffix(".png"))
+    heat.render(png)
+    print(f"{args.file}: {heat.runs} runs -> {png}")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,232 @@
+"""Level layouts as plain data, so Game can build, tile or stream them."""
+
+from __future__ import annotations
+
+import math
+import random
+from dataclasses import dataclass, field
+
+import pygame
+
+RectTuple = tuple[int, int, int, int]
+Point = tuple[int, int]
+
+
+@dataclass(frozen=True)
+class HazardSpec:
+    center: Point
+    patrol_dx: int = 140
+    vertical: bool = False
+    speed: float = 180.0
+
+    def envelope(self, size: int = 28) -> pygame.Rect:
+        """Everything the hazard can touch over a patrol; the same rect as Hazard.envelope()."""
+        if self.vertical:
+            env = pygame.Rect(0, 0, size, 2 * self.patrol_dx + size)
+        else:
+            env = pygame.Rect(0, 0, 2 * self.patrol_dx + size, size)
+        env.center = self.center
+        return env
+
+
+@dataclass
+class LevelSpec:
+    world: RectTuple
+    player_start: Point
+    goal: Point
+    walls: list[RectTuple] = field(default_factory=list)
+    coins: list[Point] = field(default_factory=list)
+    hazards: list[HazardSpec] = field(default_factory=list)
+    # Streamed levels: directory of baked chunks, and the coin total since `coins` is empty
+    chunks: str | None = None
+    total_coins: int | None = None
+
+    @property
+    def coins_needed(self) -> int:
+        return len(self.coins) if self.total_coins is None else self.total_coins
+
+
+def _boundary(world: pygame.Rect, t: int = 16) -> list[RectTuple]:
+    return [
+        (world.left, world.top, world.width, t),
+        (world.left, world.bottom - t, world.width, t),
+        (world.left, world.top, t, world.height),
+        (world.right - t, world.top, t, world.height),
+    ]
+
+
+def _arena_interior(left: int, top: int) -> tuple[list[RectTuple], list[Point], list[HazardSpec]]:
+    walls = [
+        (left + 400, top + 145, 125, 18),
+        (left + 650, top + 145, 275, 18),
+        (left + 150, top + 200, 125, 18),
+        (left + 150, top + 100, 125, 18),
+        (left, top + 300, 650, 18),
+        (left + 750, top + 355, 90, 18),
+    ]
+    coins = [
+        (left + 275, top + 380),
+        (left + 500, top + 380),
+        (left + 795, top + 250),
+        (left + 790, top + 70),
+        (left + 340, top + 155),
+        (left + 75, top + 57),
+        (left + 75, top + 255),
+    ]
+    hazards = [
+        HazardSpec((left + 587, top + 150), patrol_dx=75, vertical=True, speed=200.0),
+        HazardSpec((left + 200, top + 255), patrol_dx=160, speed=200.0),
+        HazardSpec((left + 200, top + 55), patrol_dx=160, speed=200.0),
+    ]
+    return walls, coins, hazards
+
+
+def arena(playfield: pygame.Rect) -> LevelSpec:
+    """The hand-made one-screen level."""
+    walls, coins, hazards = _arena_interior(playfield.left, playfield.top)
+    start = (playfield.left + 75, playfield.top + 380)
+    return LevelSpec(
+        world=tuple(playfield),
+        player_start=start,
+        goal=start,
+        walls=_boundary(playfield) + walls,
+        coins=coins,
+        hazards=hazards,
+    )
+
+
+def tiled(playfield: pygame.Rect, cols: int, rows: int) -> LevelSpec:
+    """The arena interior repeated cols x rows times inside one big boundary."""
+    world = pygame.Rect(playfield.left, playfield.top, playfield.width * cols, playfield.height * rows)
+    spec = LevelSpec(
+        world=tuple(world),
+        player_start=(playfield.left + 75, playfield.top + 380),
+        goal=(playfield.left + 75, playfield.top + 380),
+        walls=_boundary(world),
+    )
+    for row in range(rows):
+        for col in range(cols):
+            walls, coins, hazards = _arena_interior(
+                playfield.left + col * playfield.width,
+                playfield.top + row * playfield.height,
+            )
+            spec.walls += walls
+            spec.coins += coins
+            spec.hazards += hazards
+    return spec
+
+
+def generated(
+    playfield: pygame.Rect,
+    *,
+    walls: int = 2000,
+    coins: int = 500,
+    hazards: int = 200,
+    seed: int = 0,
+    cell: int = 96,
+) -> LevelSpec:
+    """A seeded random arena sized to its counts, for scaling tests (same seed, same level).
+
+    The world is a lattice of `cell`-pixel cells with about four cells per
+    wall, and every wall runs 1-3 cells along a lattice line. At that density
+    a few pockets get sealed off but most of the lattice stays open. An 18px
+    wall leaves cell - 18 px free between walls, so the 28px player fits
+    through any opening. Reachability is therefore a cell graph:
+    neighbours connect unless a wall covers their shared edge.
+
+    A flood fill from the start cell finds every reachable cell. The goal,
+    coins and hazards go in distinct cells the fill reached, and raising
+    ValueError is the only other outcome. Hazards patrol up to a cell each way
+    and start at least two cells from the player.
+    """
+    if cell < 18 + 28 + 2:
+        raise ValueError(f"cell {cell} is too small for the player to pass between walls")
+    rng = random.Random(seed)
+    cells = max(4 * walls, 2 * (coins + hazards + 1), (playfield.width // cell) * (playfield.height // cell))
+    cols = max(playfield.width // cell, math.ceil(math.sqrt(cells * playfield.width / playfield.height)))
+    rows = max(playfield.height // cell, math.ceil(cells / cols))
+    left, top = playfield.left, playfield.top
+    world = pygame.Rect(left, top, cols * cell, rows * cell)
+
+    # blocked_h[r * cols + c]: wall on the top edge of cell (c, r); blocked_v: on its left edge
+    blocked_h = bytearray(cols * (rows + 1))
+    blocked_v = bytearray((cols + 1) * rows)
+    spec_walls = _boundary(world)
+    t = 18
+    for _ in range(walls):
+        length = rng.randint(1, 3)
+        if rng.random() < 0.5:
+            r, c = rng.randrange(1, rows), rng.randrange(0, max(1, cols - length + 1))
+            length = min(length, cols - c)
+            for k in range(c, c + length):
+                blocked_h[r * cols + k] = 1
+            spec_walls.append((left + c * cell, top + r * cell - t // 2, length * cell, t))
+        else:
+            c, r = rng.randrange(1, cols), rng.randrange(0, max(1, rows - length + 1))
+            length = min(length, rows - r)
+            for k in range(r, r + length):
+                blocked_v[k * (cols + 1) + c] = 1
+            spec_walls.append((left + c * cell - t // 2, top + r * cell, t, length * cell))
+
+    start = (cols // 2, rows // 2)
+    reached = _flood(cols, rows, blocked_h, blocked_v, start)
+    free = [i for i in reached if i != start[1] * cols + start[0]]
+    if len(free) < 1 + coins + hazards:
+        raise ValueError(f"seed {seed}: only {len(free)} reachable cells for {1 + coins + hazards} objects")
+    # Sorted so the pick depends on the seed alone, not on fill order
+    free.sort()
+    picks = rng.sample(free, 1 + coins)
+
+    def center(i: int) -> Point:
+        r, c = divmod(i, cols)
+        return left + c * cell + cell // 2, top + r * cell + cell // 2
+
+    # Hazards may sit anywhere the player can go, except right on top of the start
+    taken = set(picks)
+    lanes = [i for i in free if i not in taken and max(abs(i % cols - start[0]), abs(i // cols - start[1])) > 2]
+    if len(lanes) < hazards:
+        raise ValueError(f"seed {seed}: only {len(lanes)} cells for {hazards} hazards away from the start")
+    spec_hazards = [
+        HazardSpec(
+            center(i),
+            patrol_dx=rng.randint(cell // 4, cell),
+            vertical=rng.random() < 0.5,
+            speed=rng.uniform(120.0, 220.0),
+        )
+        for i in rng.sample(lanes, hazards)
+    ]
+    return LevelSpec(
+        world=tuple(world),
+        player_start=center(start[1] * cols + start[0]),
+        goal=center(picks[0]),
+        walls=spec_walls,
+        coins=[center(i) for i in picks[1:]],
+        hazards=spec_hazards,
+    )
+
+
+def _flood(cols: int, rows: int, blocked_h: bytearray, blocked_v: bytearray, start: tuple[int, int]) -> list[int]:
+    """Cells (row * cols + col) reachable from start through unwalled edges."""
+    first = start[1] * cols + start[0]
+    seen = bytearray(cols * rows)
+    seen[first] = 1
+    stack = [first]
+    out = []
+    while stack:
+        i = stack.pop()
+        out.append(i)
+        r, c = divmod(i, cols)
+        # Right, left, down, up; the edge between two cells is the second one's left/top edge
+        if c + 1 < cols and not blocked_v[r * (cols + 1) + c + 1] and not seen[i + 1]:
+            seen[i + 1] = 1
+            stack.append(i + 1)
+        if c > 0 and not blocked_v[r * (cols + 1) + c] and not seen[i - 1]:
+            seen[i - 1] = 1
+            stack.append(i - 1)
+        if r + 1 < rows and not blocked_h[(r + 1) * cols + c] and not seen[i + cols]:
+            seen[i + cols] = 1
+            stack.append(i + cols)
+        if r > 0 and not blocked_h[r * cols + c] and not seen[i - cols]:
+            seen[i - cols] = 1
+            stack.append(i - cols)
+    return out
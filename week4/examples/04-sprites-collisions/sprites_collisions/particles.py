@@ -0,0 +1,97 @@
+"""Burst particles for coin pickups, damage and goal unlocks, kept in fixed numpy columns."""
+
+from __future__ import annotations
+
+import math
+
+import numpy as np
+
+from .art import CIRCLE, Look
+
+COIN, DAMAGE, UNLOCK = range(3)
+
+# Per kind: (RGBA, speed px/s, life s), speed and life drawn uniformly from their ranges
+KINDS = (
+    ((235, 203, 139, 255), (60.0, 180.0), (0.30, 0.60)),
+    ((191, 97, 106, 255), (90.0, 260.0), (0.35, 0.70)),
+    ((163, 190, 140, 255), (40.0, 220.0), (0.60, 1.10)),
+)
+# Dot art per kind: a larger dot while young, a smaller one in the second half of its life
+DOT_LOOKS: tuple[Look, ...] = tuple((CIRCLE, r, color) for color, _, _ in KINDS for r in (3, 2))
+
+GRAVITY = 260.0
+# Fraction of velocity kept per second
+DRAG = 0.12
+
+_EMPTY = (np.zeros((0, 2), np.int32), np.zeros(0, np.intp))
+
+
+class ParticlePool:
+    """Up to `capacity` live particles as parallel arrays, alive ones packed at the front.
+
+    emit() writes new particles past the live ones, and update() advances
+    them all in a few vectorized steps, then packs the survivors forward. A
+    burst that does not fit is cut short and counted in `dropped`, so the
+    cost of any frame is capped by the capacity, however much is emitted.
+    """
+
+    def __init__(self, capacity: int = 4096, *, seed: int | None = None) -> None:
+        self.capacity = capacity
+        self.pos = np.zeros((capacity, 2), np.float32)
+        self.vel = np.zeros((capacity, 2), np.float32)
+        self.life = np.zeros(capacity, np.float32)
+        # Starting life, for the age-based dot size
+        self.lifespan = np.ones(capacity, np.float32)
+        self.kind = np.zeros(capacity, np.uint8)
+        self.count = 0
+        self.dropped = 0
+        # Own generator, so bursts do not shift Game.rng (shake) sequences
+        self.rng = np.random.default_rng(seed)
+
+    def emit(self, kind: int, pos: tuple[float, float], n: int) -> None:
+        m = min(n, self.capacity - self.count)
+        self.dropped += n - m
+        if m <= 0:
+            return
+        _, (v0, v1), (l0, l1) = KINDS[kind]
+        s = slice(self.count, self.count + m)
+        angle = self.rng.uniform(0.0, 2 * math.pi, m)
+        speed = self.rng.uniform(v0, v1, m)
+        self.pos[s] = pos
+        self.vel[s, 0] = np.cos(angle) * speed
+        self.vel[s, 1] = np.sin(angle) * speed
+        self.life[s] = self.lifespan[s] = self.rng.uniform(l0, l1, m)
+        self.kind[s] = kind
+        self.count += m
+
+    def update(self, dt: float) -> None:
+        n = self.count
+        if n == 0:
+            return
+        pos, vel, life = self.pos[:n], self.vel[:n], self.life[:n]
+        life -= dt
+        vel *= DRAG**dt
+        vel[:, 1] += GRAVITY * dt
+        pos += vel * dt
+
+        alive = life > 0
+        k = int(np.count_nonzero(alive))
+        if k < n:
+            for column in (self.pos, self.vel, self.life, self.lifespan, self.kind):
+                column[:k] = column[:n][alive]
+        self.count = k
+
+    def clear(self) -> None:
+        self.count = 0
+
+    def visible(self, view: tuple[int, int, int, int]) -> tuple[np.ndarray, np.ndarray]:
+        """Live particles inside a world rect: (int world positions, DOT_LOOKS index), both copies."""
+        n = self.count
+        if n == 0:
+            return _EMPTY
+        x, y, w, h = view
+        pos = self.pos[:n]
+        inside = (pos[:, 0] >= x) & (pos[:, 0] < x + w) & (pos[:, 1] >= y) & (pos[:, 1] < y + h)
+        xy = pos[inside].astype(np.int32)
+        dot = self.kind[:n][inside].astype(np.intp) * 2 + (self.life[:n][inside] < 0.5 * self.lifespan[:n][inside])
+        return xy, dot
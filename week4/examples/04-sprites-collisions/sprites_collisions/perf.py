@@ -0,0 +1,225 @@
+"""Frame timing helpers for soak runs and benchmarks."""
+
+from __future__ import annotations
+
+import json
+import logging
+import math
+import os
+import resource
+import time
+from array import array
+from pathlib import Path
+
+log = logging.getLogger(__name__)
+
+
+def rss_mb() -> float:
+    """Current resident set size; falls back to the peak where /proc is missing."""
+    try:
+        with open("/proc/self/statm") as f:
+            pages = int(f.read().split()[1])
+        return pages * os.sysconf("SC_PAGE_SIZE") / (1024 * 1024)
+    except (OSError, ValueError, IndexError):
+        # ru_maxrss is KiB on Linux
+        return resource.getrusage(resource.RUSAGE_SELF).ru_maxrss / 1024
+
+
+class FrameStats:
+    """Frame times for the current reporting window plus running session totals.
+
+    The window is cleared by `summary()`, so memory stays bounded no matter how
+    long the session runs.
+
+    Pipelined, add() and summary() run on the simulation thread and
+    add_latency() on the render thread. summary() swaps each list for a fresh
+    one in a single assignment rather than clearing it, so a sample appended
+    mid-summary lands in the next window instead of being lost.
+    """
+
+    def __init__(self) -> None:
+        self.frames = 0
+        self.worst_ms = 0.0
+        self._window: list[float] = []
+        self._work: list[float] = []
+        self._latency: list[float] = []
+
+    def add(self, frame_s: float, work_s: float) -> None:
+        self.frames += 1
+        ms = frame_s * 1000.0
+        self.worst_ms = max(self.worst_ms, ms)
+        self._window.append(ms)
+        self._work.append(work_s * 1000.0)
+
+    def add_latency(self, seconds: float) -> None:
+        """Input-to-photon: from reading input to the flip that shows its result."""
+        self._latency.append(seconds * 1000.0)
+
+    def summary(self) -> dict[str, float]:
+        window, self._window = self._window, []
+        work, self._work = self._work, []
+        latency, self._latency = self._latency, []
+        window.sort()
+        work.sort()
+        latency.sort()
+        if not window:
+            return {"frames": 0}
+
+        def pct(values: list[float], p: float) -> float:
+            return values[min(len(values) - 1, int(p * len(values)))]
+
+        summary = {
+            "frames": len(window),
+            "fps": 1000.0 * len(window) / sum(window),
+            "frame_p50_ms": pct(window, 0.50),
+            "frame_p95_ms": pct(window, 0.95),
+            "frame_max_ms": window[-1],
+            "work_avg_ms": sum(work) / len(work),
+            "work_p99_ms": pct(work, 0.99),
+            "rss_mb": rss_mb(),
+        }
+        if latency:
+            summary["latency_p50_ms"] = pct(latency, 0.50)
+            summary["latency_p95_ms"] = pct(latency, 0.95)
+        return summary
+
+
+# Two-sided 95% Student t by degrees of freedom; gaps use the next lower entry (wider, so safe)
+_T95 = {1: 12.71, 2: 4.303, 3: 3.182, 4: 2.776, 5: 2.571, 6: 2.447, 7: 2.365, 8: 2.306, 9: 2.262, 10: 2.228,
+        15: 2.131, 20: 2.086, 30: 2.042}
+
+
+def mean_ci(values: list[float]) -> tuple[float, float]:
+    """Mean and 95% confidence half-width of a few repeated measurements."""
+    n = len(values)
+    mean = sum(values) / n
+    if n < 2:
+        return mean, 0.0
+    sd = math.sqrt(sum((v - mean) ** 2 for v in values) / (n - 1))
+    t = _T95[max(k for k in _T95 if k <= n - 1)]
+    return mean, t * sd / math.sqrt(n)
+
+
+class Histogram:
+    """HDR-style duration histogram: fixed memory, bounded relative error.
+
+    Values are whole microseconds. Below 2**SUB_BITS they are counted exactly;
+    above, each power of two is split into 2**(SUB_BITS - 1) equal buckets, so
+    a reported value is within ~1.6% of the true one. Anything over `max_s`
+    lands in the top bucket (max stays exact). Memory is one array allocated
+    up front, however many values go in.
+    """
+
+    SUB_BITS = 7
+
+    def __init__(self, max_s: float = 60.0) -> None:
+        self.sub = 1 << self.SUB_BITS
+        self.half = self.sub >> 1
+        self.top_us = int(max_s * 1_000_000)
+        octaves = max(0, self.top_us.bit_length() - self.SUB_BITS)
+        self.counts = array("Q", bytes(8 * (self.sub + self.half * octaves)))
+        self.count = 0
+        self.total_us = 0
+        self.min_us = 0
+        self.max_us = 0
+
+    def _index(self, us: int) -> int:
+        if us < self.sub:
+            return us
+        e = us.bit_length() - self.SUB_BITS
+        return self.sub + (e - 1) * self.half + (us >> e) - self.half
+
+    def _value(self, index: int) -> float:
+        """Midpoint of a bucket, in microseconds."""
+        if index < self.sub:
+            return float(index)
+        e, m = divmod(index - self.sub, self.half)
+        e += 1
+        return ((m + self.half) << e) + (1 << e) / 2
+
+    def record(self, seconds: float) -> None:
+        us = int(seconds * 1_000_000)
+        if self.count == 0 or us < self.min_us:
+            self.min_us = us
+        if us > self.max_us:
+            self.max_us = us
+        self.count += 1
+        self.total_us += us
+        self.counts[self._index(min(us, self.top_us))] += 1
+
+    def percentile(self, p: float) -> float:
+        """Value at fraction p (0..1) of the recorded values, in milliseconds."""
+        if self.count == 0:
+            return 0.0
+        rank = max(1, round(p * self.count))
+        seen = 0
+        for index, n in enumerate(self.counts):
+            seen += n
+            if seen >= rank:
+                # A bucket midpoint can overshoot the largest value actually seen
+                return min(self._value(index), self.max_us) / 1000.0
+        return self.max_us / 1000.0
+
+    def summary(self) -> dict[str, float]:
+        if self.count == 0:
+            return {"count": 0}
+        return {
+            "count": self.count,
+            "min_ms": self.min_us / 1000.0,
+            "mean_ms": round(self.total_us / self.count / 1000.0, 3),
+            "p50_ms": self.percentile(0.50),
+            "p90_ms": self.percentile(0.90),
+            "p99_ms": self.percentile(0.99),
+            "p99_9_ms": self.percentile(0.999),
+            "max_ms": self.max_us / 1000.0,
+        }
+
+
+class SessionReport:
+    """Whole-session frame, update and draw histograms, written as one JSON report at exit.
+
+    `frame` is the interval between presents, so a frame that took more than
+    1.5 display periods counts as missing round(frame / period) - 1 vsync
+    deadlines. Update and draw may be recorded from different threads (the
+    pipelined loop); each histogram only ever has one writer.
+    """
+
+    def __init__(self, *, fps: int) -> None:
+        self.fps = fps
+        self.period = 1.0 / fps
+        self.frame = Histogram()
+        self.update = Histogram()
+        self.draw = Histogram()
+        self.missed_frames = 0
+        self.missed_deadlines = 0
+        self.started = time.time()
+        self._last_present: float | None = None
+
+    def presented(self, now: float) -> None:
+        """Call once per present with its perf_counter time."""
+        if self._last_present is not None:
+            frame_s = now - self._last_present
+            self.frame.record(frame_s)
+            missed = round(frame_s / self.period) - 1
+            if missed > 0:
+                self.missed_frames += 1
+                self.missed_deadlines += missed
+        self._last_present = now
+
+    def write(self, path: str | Path, **context: object) -> None:
+        """Dump the report; `context` (level, object counts, ...) is stored as given."""
+        report = {
+            "started": time.strftime("%Y-%m-%dT%H:%M:%S", time.localtime(self.started)),
+            "duration_s": round(time.time() - self.started, 3),
+            "target_fps": self.fps,
+            **context,
+            "missed_vsync": {"frames": self.missed_frames, "deadlines": self.missed_deadlines},
+            "frame": self.frame.summary(),
+            "update": self.update.summary(),
+            "draw": self.draw.summary(),
+            "rss_mb": round(rss_mb(), 1),
+        }
+        with open(path, "w") as f:
+            json.dump(report, f, indent=2)
+            f.write("\n")
+        log.info("report: %d frames, %d missed vsync deadlines -> %s", self.frame.count, self.missed_deadlines, path)
@@ -0,0 +1,144 @@
+"""Pipelined frames: simulation on a worker thread, rendering on the main thread.
+
+The simulation publishes an immutable FrameSnapshot per tick; the main thread
+keeps the window, pumps events, and renders and flips the newest snapshot. A
+slow flip then delays only the picture, not input handling or the simulation.
+"""
+
+from __future__ import annotations
+
+import queue
+import threading
+import time
+from dataclasses import dataclass
+from typing import TYPE_CHECKING, Callable
+
+import pygame
+
+if TYPE_CHECKING:
+    import numpy as np
+
+    from .art import Look
+    from .tiles import TileCache
+
+Box = tuple[int, int, int, int]
+
+
+@dataclass(frozen=True)
+class FrameSnapshot:
+    """Everything Game.render needs for one frame, as plain values.
+
+    Built by Game.snapshot() on the simulation side. Boxes are world-space
+    (x, y, w, h) tuples; colors are shared pygame.Color objects that nothing
+    mutates. `input_time` is the perf_counter time at which the input this
+    frame reflects was read, for input-to-photon latency.
+    """
+
+    input_time: float
+    state: str
+    hud: str
+    # Whole-world offset this frame, in logical pixels; applied when compositing the world layer
+    shake: tuple[float, float]
+    # World -> logical screen offset of the camera (no shake)
+    cam: tuple[int, int]
+    view: Box
+    tiles: TileCache
+    # Visible sprites as (look, anchor x, anchor y) in world pixels, bottom layer first (see art.py)
+    sprites: tuple[tuple[Look, int, int], ...]
+    # Particles in view: (int32 world positions, particles.DOT_LOOKS index), copies owned by the snapshot
+    particles: tuple[np.ndarray, np.ndarray]
+    # Debug overlay: hitboxes in draw order, and the stats line (None when debug is off)
+    debug_boxes: tuple[tuple[Box, pygame.Color], ...]
+    debug_text: str | None
+
+
+class SnapshotBuffer:
+    """Latest-wins handoff of snapshots from the simulation to the renderer.
+
+    A triple buffer without the copies: snapshots are immutable, so the
+    simulation builds the next one while the renderer still draws the last,
+    and publishing is a reference swap. The simulation never waits; the
+    renderer skips any snapshot it was too slow to show.
+    """
+
+    def __init__(self) -> None:
+        self._cond = threading.Condition()
+        self._snap: FrameSnapshot | None = None
+        self._seq = 0
+        self.skipped = 0
+
+    def publish(self, snap: FrameSnapshot) -> None:
+        with self._cond:
+            self._snap = snap
+            self._seq += 1
+            self._cond.notify_all()
+
+    def wait_newer(self, seq: int, timeout: float) -> tuple[int, FrameSnapshot | None]:
+        """Newest snapshot after sequence number seq, or None on timeout."""
+        with self._cond:
+            if not self._cond.wait_for(lambda: self._seq != seq, timeout):
+                return seq, None
+            self.skipped += self._seq - seq - 1 if seq else 0
+            return self._seq, self._snap
+
+
+class SimulationThread(threading.Thread):
+    """Runs input handling and fixed-rate update ticks, publishing a snapshot after each.
+
+    `step(dt, input_time)` advances the game and returns its snapshot. Events
+    pumped on the main thread arrive through `post()` with the time they were
+    read; a tick's `input_time` is the oldest such event, or the tick start
+    when there were none (polled key state and the autopilot read input then).
+
+    `on_idle(deadline)` runs after each tick with the perf_counter time the
+    next one is due, for work that should only use the slack (GcPolicy.idle).
+    """
+
+    def __init__(
+        self,
+        handle_event: Callable[[pygame.event.Event], None],
+        step: Callable[[float, float], FrameSnapshot],
+        buffer: SnapshotBuffer,
+        *,
+        fps: int,
+        on_tick: Callable[[float, float], None] | None = None,
+        on_idle: Callable[[float], None] | None = None,
+    ) -> None:
+        super().__init__(name="simulation", daemon=True)
+        self.handle_event = handle_event
+        self.step = step
+        self.buffer = buffer
+        self.fps = fps
+        self.on_tick = on_tick
+        self.on_idle = on_idle
+        self.error: BaseException | None = None
+        self._events: queue.SimpleQueue[tuple[pygame.event.Event, float]] = queue.SimpleQueue()
+        self._stopping = threading.Event()
+
+    def post(self, event: pygame.event.Event) -> None:
+        self._events.put((event, time.perf_counter()))
+
+    def stop(self) -> None:
+        self._stopping.set()
+
+    def run(self) -> None:
+        try:
+            clock = pygame.time.Clock()
+            while not self._stopping.is_set():
+                frame_s = clock.tick(self.fps) / 1000.0
+                start = time.perf_counter()
+                input_time = start
+                while True:
+                    try:
+                        event, seen = self._events.get_nowait()
+                    except queue.Empty:
+                        break
+                    input_time = min(input_time, seen)
+                    self.handle_event(event)
+                self.buffer.publish(self.step(min(frame_s, 0.05), input_time))
+                if self.on_tick is not None:
+                    self.on_tick(frame_s, time.perf_counter() - start)
+                if self.on_idle is not None:
+                    self.on_idle(start + 1.0 / self.fps)
+        except BaseException as exc:  # surfaced on the main thread
+            self.error = exc
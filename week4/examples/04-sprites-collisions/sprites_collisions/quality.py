@@ -0,0 +1,128 @@
+"""Adaptive quality: step render features down when frames go over budget, back up when they fit."""
+
+from __future__ import annotations
+
+import logging
+import time
+from collections import deque
+from dataclasses import dataclass
+from typing import TYPE_CHECKING
+
+if TYPE_CHECKING:
+    from .game import Game
+
+log = logging.getLogger(__name__)
+
+
+@dataclass(frozen=True)
+class Tier:
+    """What the renderers may spend on one frame. Read by Game.render and TextureRenderer."""
+
+    name: str
+    # Black outline pass on coins, hazards, goals and the player
+    outlines: bool = True
+    # Translucent panel behind the centre message
+    overlays: bool = True
+    # Multiplies the configured render scale
+    scale: float = 1.0
+    # Seconds between HUD text changes (0 = every frame)
+    hud_interval: float = 0.0
+
+
+# Cheapest changes first: each tier keeps everything the one above it dropped.
+# Names are short because the debug HUD line shows them.
+TIERS = (
+    Tier("full"),
+    # Flat-shaded sprites
+    Tier("flat", outlines=False),
+    # Plus no overlay panel, HUD text at most 4x a second
+    Tier("lite", outlines=False, overlays=False, hud_interval=0.25),
+    # Plus fewer pixels: 0.56x and 0.25x the fill of the configured render scale
+    Tier("low", outlines=False, overlays=False, scale=0.75, hud_interval=0.5),
+    Tier("min", outlines=False, overlays=False, scale=0.5, hud_interval=0.5),
+)
+
+
+class QualityGovernor:
+    """Watches rolling frame work times and moves the game between quality tiers.
+
+    Feed it one observe() per frame with the time spent on that frame (not the
+    time spent sleeping to hold the frame rate). Once `window` samples are in,
+    the 90th percentile decides: over budget steps one tier down right away;
+    under `headroom` x budget for `hold_s` seconds steps one tier up. Samples
+    are dropped after every change, and the first `settle` frames after it are
+    ignored, since a scale change re-renders every background tile.
+
+    A tier that was just left for being too slow is retried only after twice
+    the previous wait, so a load that sits on a tier boundary does not make
+    quality flicker every few seconds.
+
+    Changes go through Game.request_quality, so observe() may run on either
+    thread of the pipelined loop; the switch itself happens in the next present().
+    """
+
+    def __init__(
+        self,
+        game: Game,
+        *,
+        budget_ms: float,
+        tiers: tuple[Tier, ...] = TIERS,
+        window: int = 60,
+        headroom: float = 0.6,
+        hold_s: float = 3.0,
+        settle: int = 10,
+    ) -> None:
+        self.game = game
+        self.budget_ms = budget_ms
+        self.tiers = tiers
+        self.headroom = headroom
+        self.settle = settle
+        self.level = 0
+        self.changes = 0
+
+        self._samples: deque[float] = deque(maxlen=window)
+        self._skip = 0
+        self._hold = [hold_s] * len(tiers)
+        self._base_hold = hold_s
+        self._changed_at = time.perf_counter()
+        # When the current tier was entered by stepping up; a quick drop back means it was premature
+        self._raised_at: float | None = None
+        game.set_quality(tiers[0])
+
+    @property
+    def tier(self) -> Tier:
+        return self.tiers[self.level]
+
+    def observe(self, work_s: float) -> None:
+        if self._skip:
+            self._skip -= 1
+            return
+        self._samples.append(work_s * 1000.0)
+        if len(self._samples) < self._samples.maxlen:
+            return
+
+        ordered = sorted(self._samples)
+        p90 = ordered[int(0.9 * len(ordered))]
+        now = time.perf_counter()
+        if p90 > self.budget_ms and self.level < len(self.tiers) - 1:
+            if self._raised_at is not None and now - self._raised_at < 2 * self._hold[self.level]:
+                # Just stepped up into this tier and it does not fit: wait longer before trying it again
+                self._hold[self.level] = min(8 * self._base_hold, 2 * self._hold[self.level])
+            self._raised_at = None
+            self._set(self.level + 1, p90, now)
+        elif p90 < self.headroom * self.budget_ms and self.level > 0:
+            if now - self._changed_at >= self._hold[self.level - 1]:
+                self._raised_at = now
+                self._set(self.level - 1, p90, now)
+
+    def _set(self, level: int, p90: float, now: float) -> None:
+        old = self.tier
+        self.level = level
+        self.changes += 1
+        self._changed_at = now
+        self._samples.clear()
+        self._skip = self.settle
+        log.info(
+            "quality %s -> %s (work p90 %.2f ms, budget %.2f ms)", old.name, self.tier.name, p90, self.budget_ms
+        )
+        self.game.request_quality(self.tier)
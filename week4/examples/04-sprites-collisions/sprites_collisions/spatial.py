@@ -0,0 +1,83 @@
+"""Uniform-grid spatial index for culling and neighbourhood queries."""
+
+from __future__ import annotations
+
+from typing import Generic, Hashable, Iterator, TypeVar
+
+import pygame
+
+T = TypeVar("T", bound=Hashable)
+
+
+class SpatialGrid(Generic[T]):
+    """Buckets items by the grid cells their bounds overlap.
+
+    Bounds are captured at insert time, so moving items should be inserted
+    with a rect that covers everywhere they can go (e.g. a hazard's patrol
+    envelope). Query results come back in a deterministic order.
+
+    query() keeps no state of its own, so threads may query one grid at
+    the same time. insert/remove/clear must not overlap a query; Game
+    changes its wall grid under the tile cache's lock for that reason.
+    """
+
+    def __init__(self, cell: int = 256) -> None:
+        self.cell = cell
+        self._cells: dict[tuple[int, int], list[T]] = {}
+        self._bounds: dict[T, pygame.Rect] = {}
+
+    def __len__(self) -> int:
+        return len(self._bounds)
+
+    def __contains__(self, item: object) -> bool:
+        return item in self._bounds
+
+    def _keys(self, rect: pygame.Rect) -> Iterator[tuple[int, int]]:
+        c = self.cell
+        # right/bottom are exclusive, hence the -1
+        for cy in range(rect.top // c, (rect.bottom - 1) // c + 1):
+            for cx in range(rect.left // c, (rect.right - 1) // c + 1):
+                yield cx, cy
+
+    def insert(self, item: T, bounds: pygame.Rect) -> None:
+        if item in self._bounds:
+            self.remove(item)
+        self._bounds[item] = bounds
+        for key in self._keys(bounds):
+            self._cells.setdefault(key, []).append(item)
+
+    def remove(self, item: T) -> None:
+        bounds = self._bounds.pop(item, None)
+        if bounds is None:
+            return
+        for key in self._keys(bounds):
+            bucket = self._cells[key]
+            bucket.remove(item)
+            if not bucket:
+                del self._cells[key]
+
+    def clear(self) -> None:
+        self._cells.clear()
+        self._bounds.clear()
+
+    def query(self, rect: pygame.Rect, out: list[T] | None = None) -> list[T]:
+        """Items whose bounds overlap rect; pass `out` to have it cleared and filled instead of a new list."""
+        # Per call, not a member: the sim and render threads both query the wall grid
+        found: dict[T, None] = {}
+        bounds = self._bounds
+        cells = self._cells
+        c = self.cell
+        # Same cells as _keys(), without the generator
+        for cy in range(rect.top // c, (rect.bottom - 1) // c + 1):
+            for cx in range(rect.left // c, (rect.right - 1) // c + 1):
+                bucket = cells.get((cx, cy))
+                if bucket is None:
+                    continue
+                for item in bucket:
+                    if item not in found and rect.colliderect(bounds[item]):
+                        found[item] = None
+        if out is None:
+            return list(found)
+        out.clear()
+        out.extend(found)
+        return out
@@ -0,0 +1,272 @@
+"""Chunked level storage: bake a LevelSpec to disk, then stream it in around the player."""
+
+from __future__ import annotations
+
+import json
+import os
+import pickle
+import shutil
+from collections import OrderedDict
+from concurrent.futures import Future, ThreadPoolExecutor
+from dataclasses import dataclass, field
+from pathlib import Path
+from typing import TYPE_CHECKING, Any, Callable
+
+import pygame
+
+from .levels import HazardSpec, LevelSpec
+
+if TYPE_CHECKING:
+    from .game import Coin, Game, Hazard, Wall
+
+ChunkKey = tuple[int, int]
+
+CHUNK_SIZE = 1024
+
+
+def _chunk_name(key: ChunkKey) -> str:
+    return f"chunk_{key[0]}_{key[1]}.pkl"
+
+
+def bake(spec: LevelSpec, directory: str | Path, *, chunk: int = CHUNK_SIZE) -> None:
+    """Split a level into fixed-size chunk files plus a JSON manifest.
+
+    Walls that cross chunk borders are clipped into one piece per chunk, so a
+    chunk is self-contained. Coins belong to the chunk holding their centre.
+    Hazards go into every chunk their patrol envelope overlaps, so one is
+    present wherever it can reach. Both get a level-wide id: collected coins
+    stay collected, and a hazard in several resident chunks spawns once.
+    """
+    directory = Path(directory)
+    directory.mkdir(parents=True, exist_ok=True)
+
+    chunks: dict[ChunkKey, dict[str, list[Any]]] = {}
+
+    def bucket(key: ChunkKey) -> dict[str, list[Any]]:
+        return chunks.setdefault(key, {"walls": [], "coins": [], "hazards": []})
+
+    for r in spec.walls:
+        rect = pygame.Rect(r)
+        for cy in range(rect.top // chunk, (rect.bottom - 1) // chunk + 1):
+            for cx in range(rect.left // chunk, (rect.right - 1) // chunk + 1):
+                piece = rect.clip(pygame.Rect(cx * chunk, cy * chunk, chunk, chunk))
+                bucket((cx, cy))["walls"].append(tuple(piece))
+
+    for uid, (x, y) in enumerate(spec.coins):
+        bucket((x // chunk, y // chunk))["coins"].append((uid, (x, y)))
+
+    for uid, hs in enumerate(spec.hazards):
+        env = hs.envelope()
+        for cy in range(env.top // chunk, (env.bottom - 1) // chunk + 1):
+            for cx in range(env.left // chunk, (env.right - 1) // chunk + 1):
+                bucket((cx, cy))["hazards"].append((uid, hs))
+
+    for key, data in chunks.items():
+        with open(directory / _chunk_name(key), "wb") as f:
+            pickle.dump(data, f, protocol=pickle.HIGHEST_PROTOCOL)
+
+    manifest = {
+        "chunk": chunk,
+        "world": list(spec.world),
+        "player_start": list(spec.player_start),
+        "goal": list(spec.goal),
+        "total_coins": spec.coins_needed,
+        "chunks": sorted(chunks),
+    }
+    with open(directory / "manifest.json", "w") as f:
+        json.dump(manifest, f)
+
+
+def open_level(directory: str | Path) -> Callable[[pygame.Rect], LevelSpec]:
+    """Level factory for Game(level=...) that only carries what is not chunked."""
+    directory = Path(directory)
+    with open(directory / "manifest.json") as f:
+        manifest = json.load(f)
+
+    def factory(playfield: pygame.Rect) -> LevelSpec:
+        return LevelSpec(
+            world=tuple(manifest["world"]),
+            player_start=tuple(manifest["player_start"]),
+            goal=tuple(manifest["goal"]),
+            chunks=str(directory),
+            total_coins=manifest["total_coins"],
+        )
+
+    return factory
+
+
+@dataclass
+class _Chunk:
+    data: dict[str, list[Any]]
+    walls: list[Wall] = field(default_factory=list)
+    coins: list[Coin] = field(default_factory=list)
+    hazards: list[Hazard] = field(default_factory=list)
+
+
+class ChunkStreamer:
+    """Keeps the chunks around the player resident and everything else on disk.
+
+    Reads (and write-backs of evicted chunks) run on one background thread, so
+    they stay in order. Finished loads become sprites on the main thread, at
+    most `loads_per_frame` chunks a frame, nearest first. Chunks are requested
+    `load_radius` chunks out and only evicted one chunk further than that, so
+    a chunk is normally in memory well before it scrolls into view and the
+    player can wobble across a border without churning loads.
+
+    `max_resident` bounds memory; the least recently wanted chunks go first.
+
+    State saved on eviction: coins that were collected are dropped from the
+    chunk and it is written to `state/`, which shadows the baked files until
+    the next reset. Hazards need nothing saved, since their motion is a pure
+    function of the level clock and re-added hazards are seeked to it. A
+    hazard listed by several resident chunks is spawned by the first and
+    removed with the last.
+    """
+
+    def __init__(
+        self,
+        game: Game,
+        directory: Path,
+        *,
+        load_radius: int = 1,
+        max_resident: int = 16,
+        loads_per_frame: int = 1,
+    ) -> None:
+        self.game = game
+        self.directory = directory
+        with open(directory / "manifest.json") as f:
+            manifest = json.load(f)
+        self.size: int = manifest["chunk"]
+        self.available = {tuple(k) for k in manifest["chunks"]}
+
+        self.load_radius = load_radius
+        # The whole load ring must fit, or it would evict what it just loaded
+        self.max_resident = max(max_resident, (2 * load_radius + 1) ** 2)
+        self.loads_per_frame = loads_per_frame
+
+        self.state_dir = directory / "state"
+        shutil.rmtree(self.state_dir, ignore_errors=True)
+        self.state_dir.mkdir()
+
+        self.resident: OrderedDict[ChunkKey, _Chunk] = OrderedDict()
+        # Hazard id -> (hazard, resident chunks listing it)
+        self._hazards: dict[int, tuple[Hazard, int]] = {}
+        self.pending: dict[ChunkKey, Future[dict[str, list[Any]]]] = {}
+        self._io = ThreadPoolExecutor(max_workers=1, thread_name_prefix="chunk-io")
+
+        self.loads = 0
+        self.evictions = 0
+
+    # Background thread
+
+    def _read(self, key: ChunkKey) -> dict[str, list[Any]]:
+        path = self.state_dir / _chunk_name(key)
+        if not path.exists():
+            path = self.directory / _chunk_name(key)
+        with open(path, "rb") as f:
+            return pickle.load(f)
+
+    def _write(self, key: ChunkKey, data: dict[str, list[Any]]) -> None:
+        path = self.state_dir / _chunk_name(key)
+        tmp = path.with_suffix(".tmp")
+        with open(tmp, "wb") as f:
+            pickle.dump(data, f, protocol=pickle.HIGHEST_PROTOCOL)
+        os.replace(tmp, path)
+
+    # Main thread
+
+    def _key(self, pos: tuple[float, float]) -> ChunkKey:
+        return int(pos[0] // self.size), int(pos[1] // self.size)
+
+    def _wanted(self, pos: tuple[float, float]) -> list[ChunkKey]:
+        cx, cy = self._key(pos)
+        r = self.load_radius
+        keys = [
+            (cx + dx, cy + dy)
+            for dy in range(-r, r + 1)
+            for dx in range(-r, r + 1)
+            if (cx + dx, cy + dy) in self.available
+        ]
+        keys.sort(key=lambda k: max(abs(k[0] - cx), abs(k[1] - cy)))
+        return keys
+
+    def _attach(self, key: ChunkKey, data: dict[str, list[Any]]) -> None:
+        game = self.game
+        chunk = _Chunk(data)
+        for r in data["walls"]:
+            chunk.walls.append(game.add_wall(pygame.Rect(r)))
+        for _, center in data["coins"]:
+            chunk.coins.append(game.add_coin(center))
+        for uid, hs in data["hazards"]:
+            hazard, refs = self._hazards.get(uid) or (None, 0)
+            if hazard is None:
+                hazard = game.add_hazard(hs)
+            self._hazards[uid] = (hazard, refs + 1)
+            chunk.hazards.append(hazard)
+        self.resident[key] = chunk
+        self.loads += 1
+        game.layout_version += 1
+
+    def _detach(self, key: ChunkKey) -> None:
+        game = self.game
+        chunk = self.resident.pop(key)
+        remaining = [entry for entry, coin in zip(chunk.data["coins"], chunk.coins) if coin.alive()]
+        if len(remaining) != len(chunk.data["coins"]):
+            self._io.submit(self._write, key, dict(chunk.data, coins=remaining))
+        for sprite in (*chunk.walls, *chunk.coins):
+            game.remove_sprite(sprite)
+        for uid, _ in chunk.data["hazards"]:
+            hazard, refs = self._hazards[uid]
+            if refs > 1:
+                self._hazards[uid] = (hazard, refs - 1)
+            else:
+                del self._hazards[uid]
+                game.remove_sprite(hazard)
+        self.evictions += 1
+        game.layout_version += 1
+
+    def resident_bounds(self) -> pygame.Rect:
+        """Bounding rect of the chunks currently in memory."""
+        keys = list(self.resident) or [(0, 0)]
+        xs = [k[0] for k in keys]
+        ys = [k[1] for k in keys]
+        s = self.size
+        return pygame.Rect(min(xs) * s, min(ys) * s, (max(xs) - min(xs) + 1) * s, (max(ys) - min(ys) + 1) * s)
+
+    def load_around(self, pos: tuple[float, float]) -> None:
+        """Blocking load of the whole ring; used once at level start."""
+        for key in self._wanted(pos):
+            if key not in self.resident:
+                self._attach(key, self._read(key))
+
+    def update(self, pos: tuple[float, float]) -> None:
+        wanted = self._wanted(pos)
+        for key in wanted:
+            if key in self.resident:
+                self.resident.move_to_end(key)
+            elif key not in self.pending:
+                self.pending[key] = self._io.submit(self._read, key)
+
+        budget = self.loads_per_frame
+        for key in wanted:
+            future = self.pending.get(key)
+            if budget > 0 and future is not None and future.done():
+                del self.pending[key]
+                self._attach(key, future.result())
+                budget -= 1
+
+        # Loads we no longer want: drop them once they land
+        wanted_set = set(wanted)
+        for key in [k for k, f in self.pending.items() if k not in wanted_set and f.done()]:
+            del self.pending[key]
+
+        cx, cy = self._key(pos)
+        keep = self.load_radius + 1
+        for key in [k for k in self.resident if max(abs(k[0] - cx), abs(k[1] - cy)) > keep]:
+            self._detach(key)
+        while len(self.resident) > self.max_resident:
+            self._detach(next(iter(self.resident)))
+
+    def close(self) -> None:
+        # Let pending write-backs finish before the next reset wipes state/
+        self._io.shutdown(wait=True, cancel_futures=False)
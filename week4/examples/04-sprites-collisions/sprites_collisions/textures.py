@@ -0,0 +1,221 @@
+"""SDL2 Renderer/Texture backend: draws FrameSnapshots with pre-uploaded textures.
+
+Selected with Game(renderer="texture"). The window belongs to a
+pygame._sdl2 Window instead of pygame.display, and every frame is a handful
+of texture copies plus a few filled rects. SDL picks a GPU renderer when there
+is one and its software renderer otherwise (or when SDL_RENDER_DRIVER=software).
+"""
+
+from __future__ import annotations
+
+import os
+from typing import TYPE_CHECKING
+
+import pygame
+from pygame._sdl2.video import Renderer, Texture, Window
+
+if TYPE_CHECKING:
+    from .game import Game
+    from .pipeline import FrameSnapshot
+
+_BLACK = pygame.Color("#000000")
+# SDL_BLENDMODE_BLEND, for the translucent message overlay
+_BLEND = 1
+
+
+class TextureRenderer:
+    """Renders snapshots for one Game into its own window.
+
+    Sprite art comes from the game's ArtCache, the same images the Surface
+    backend blits, and is uploaded once per look and outline setting, then
+    reused every frame. Background tiles are uploaded when the
+    TileCache produces them and re-uploaded only when the cache replaces a
+    tile. Text is cached per string, since the HUD only changes when the score
+    or hp does.
+
+    Shake is one offset added to every world copy, which puts the pixels
+    exactly where the Surface backend's shifted world layer does.
+    """
+
+    def __init__(self, game: Game, *, title: str = "pygame") -> None:
+        self.game = game
+        self.canvas = game.canvas
+        self.window = Window(title, size=self.canvas.window)
+        try:
+            self.renderer = Renderer(self.window, vsync=False)
+        except pygame.error:
+            # No usable GPU driver; SDL's software renderer always works
+            self.renderer = Renderer(self.window, accelerated=0)
+
+        self._art: dict[tuple, tuple[Texture, int, int]] = {}
+        self._tiles: dict[tuple[int, int], tuple[pygame.Surface, Texture]] = {}
+        self._text: dict[tuple, Texture] = {}
+        self.uploads = 0
+        # Renderer calls made by the last frame (debug view)
+        self.draw_calls = 0
+        self.resize()
+
+    def resize(self) -> None:
+        """Follow the canvas: render into an internal-size target unless it matches the window."""
+        self._art.clear()
+        self._text.clear()
+        self._tiles.clear()
+        self.target: Texture | None = None
+        if self.canvas.size != self.canvas.window:
+            # SDL reads the filter for a texture's scaling when the texture is created
+            os.environ["SDL_RENDER_SCALE_QUALITY"] = "1" if self.canvas.smooth else "0"
+            self.target = Texture(self.renderer, self.canvas.size, target=True)
+
+    # Texture caches
+
+    def _upload(self, surf: pygame.Surface) -> Texture:
+        self.uploads += 1
+        return Texture.from_surface(self.renderer, surf)
+
+    def _sprite(self, key: tuple, outline: bool) -> tuple[Texture, int, int]:
+        """(texture, dx, dy) for an internal look (see ArtCache); dx/dy place it relative to its anchor."""
+        art = self._art.get((key, outline))
+        if art is None:
+            image, dx, dy = self.game.art.image(key, outline)
+            art = self._art[(key, outline)] = (self._upload(image), dx, dy)
+        return art
+
+    def _label(self, text: str, color: pygame.Color, *, big: bool = False, bg: pygame.Color | None = None) -> Texture:
+        # Text on a known flat background is pre-blended and opaque, so it matches the Surface backend exactly
+        key = (text, big, tuple(color), bg and tuple(bg))
+        tex = self._text.get(key)
+        if tex is None:
+            if len(self._text) > 64:
+                self._text.clear()
+            font = self.game.big_font if big else self.game.font
+            surf = font.render(text, True, color)
+            if bg is not None:
+                # Blend onto the background here, exactly as a blit onto the panel would
+                flat = pygame.Surface(surf.get_size())
+                flat.fill(bg)
+                flat.blit(surf, (0, 0))
+                surf = flat
+            tex = self._text[key] = self._upload(surf)
+        return tex
+
+    # Drawing
+
+    def render(self, snap: FrameSnapshot) -> None:
+        game, r, c = self.game, self.renderer, self.canvas
+        palette = game.palette
+        outline = game.quality.outlines
+        ox, oy = snap.cam
+        shx, shy = shift = c.point(snap.shake)
+        calls = 1
+
+        r.target = self.target
+        r.draw_color = palette.bg
+        r.clear()
+
+        # Static layer: one texture per background tile
+        sx, sy = c.px(ox) + shx, c.px(oy) + shy
+        visible = snap.tiles.visible(pygame.Rect(snap.view))
+        for tile, surf, walls in visible:
+            dst = c.rect(tile).move(sx, sy)
+            if surf is None:
+                r.draw_color = palette.bg
+                r.fill_rect(dst)
+                for rect, color in walls:
+                    r.draw_color = color
+                    r.fill_rect(c.rect(rect).move(c.px(ox) + shx, c.px(oy) + shy).clip(dst))
+                calls += 1 + len(walls)
+                continue
+            cached = self._tiles.get(tile.topleft)
+            if cached is None or cached[0] is not surf:
+                cached = self._tiles[tile.topleft] = (surf, self._upload(surf))
+            cached[1].draw(dstrect=dst.topleft)
+            calls += 1
+        if len(self._tiles) > 4 * len(visible) + 16:
+            keep = {tile.topleft for tile, _, _ in visible}
+            self._tiles = {key: v for key, v in self._tiles.items() if key in keep}
+
+        # One texture copy per sprite, bottom layer first
+        key, sprite = game.art.key, self._sprite
+        for look, x, y in snap.sprites:
+            k, px, py = key(look, x + ox, y + oy)
+            tex, dx, dy = sprite(k, outline)
+            tex.draw(dstrect=(px + dx + shx, py + dy + shy))
+        calls += len(snap.sprites)
+
+        # Particles: positions for all of them in one numpy pass, then a texture copy each
+        xy, dot = snap.particles
+        if len(xy):
+            dots = [sprite(k, False)[0] for k in game.dot_keys()]
+            for d, (px, py) in zip(dot.tolist(), game.dot_positions(snap)):
+                dots[d].draw(dstrect=(px + shx, py + shy))
+            calls += len(xy)
+
+        if snap.debug_text is not None:
+            for box, color in snap.debug_boxes:
+                r.draw_color = color
+                edge = c.rect(pygame.Rect(box).move(ox, oy)).move(shift)
+                for _ in range(c.width(2)):
+                    r.draw_rect(edge)
+                    edge = edge.inflate(-2, -2)
+                    calls += 1
+
+        # HUD last: it covers anything the world drew above the HUD line (no clip rect here)
+        r.draw_color = palette.panel
+        r.fill_rect(c.rect((0, 0, game.SCREEN_W, game.HUD_H)))
+        r.draw_color = _BLACK
+        r.fill_rect(c.rect((0, game.HUD_H, game.SCREEN_W, 1)))
+        panel = palette.panel
+        self._label(snap.hud, palette.text, bg=panel).draw(dstrect=c.point((14, 18)))
+        hint = "WASD/Arrows move • F1 debug • R reset • Esc quit"
+        self._label(hint, palette.subtle, bg=panel).draw(dstrect=c.point((14, 36)))
+        calls += 4
+        if snap.debug_text is not None:
+            hint = "DEBUG: Rect hitboxes (collisions use these)"
+            self._label(hint, palette.text, bg=panel).draw(dstrect=c.point((game.SCREEN_W - 320, 18)))
+            tex = self._label(f"{snap.debug_text}  Draws: {self.draw_calls}", palette.subtle, bg=panel)
+            tex.draw(dstrect=(min(c.px(game.SCREEN_W - 320), c.px(game.SCREEN_W - 8) - tex.width), c.px(36)))
+            calls += 2
+
+        message = game.CENTER_MESSAGES.get(snap.state)
+        if message is not None:
+            calls += self._center_message(message, shift, overlay=game.quality.overlays)
+        self.draw_calls = calls
+
+    def _center_message(self, message: str, shift: tuple[int, int], *, overlay: bool = True) -> int:
+        game, r, c = self.game, self.renderer, self.canvas
+        sx, sy = shift
+        lines = message.split("\n")
+        y = game.playfield.centery - len(lines) * 44 // 2
+
+        if overlay:
+            r.draw_blend_mode = _BLEND
+            r.draw_color = (0, 0, 0, 150)
+            r.fill_rect(c.rect(game.playfield).move(sx, sy))
+            r.draw_blend_mode = 0
+
+        for line in lines:
+            tex = self._label(line, game.palette.text, big=True)
+            tex.draw(dstrect=(c.px(game.playfield.centerx) - tex.width // 2 + sx, c.px(y) + sy))
+            y += 44
+        return len(lines) + (1 if overlay else 0)
+
+    def present(self) -> None:
+        if self.target is not None:
+            # One scaled copy of the internal frame to the window, letterboxed
+            r = self.renderer
+            r.target = None
+            r.draw_color = (0, 0, 0, 255)
+            r.clear()
+            self.target.draw(dstrect=self.canvas.dest)
+        self.renderer.present()
+
+    def to_surface(self) -> pygame.Surface:
+        """Read back the last frame at internal resolution (screenshots, tests); slow."""
+        return self.renderer.to_surface()
+
+    def read_into(self, surface: pygame.Surface) -> None:
+        """Read the frame render() just drew into an existing surface of canvas size (capture).
+
+        Call it before present(), while the internal target is still bound.
+        """
+        self.renderer.to_surface(surface=surface)
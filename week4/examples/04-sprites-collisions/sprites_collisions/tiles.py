@@ -0,0 +1,228 @@
+"""Pre-rendered background tiles: static wall geometry baked into fixed-size surfaces."""
+
+from __future__ import annotations
+
+import threading
+from collections import OrderedDict
+from concurrent.futures import Future, ThreadPoolExecutor
+from typing import Callable, Iterable
+
+import pygame
+
+TileKey = tuple[int, int]
+WallList = list[tuple[tuple[int, int, int, int], pygame.Color]]
+
+# Walls of a ready tile: nothing to draw directly (shared, never mutated)
+_NO_WALLS: WallList = []
+
+
+def _scaled(r: tuple[int, int, int, int], k: float) -> tuple[int, int, int, int]:
+    # Scale edges, not sizes, so neighbours stay flush (same rule as Canvas.rect)
+    x, y, w, h = r
+    if k == 1:
+        return x, y, w, h
+    x0, y0 = round(x * k), round(y * k)
+    return x0, y0, round((x + w) * k) - x0, round((y + h) * k) - y0
+
+
+def _render(
+    pixels: tuple[int, int, int, int], scale: float, bg: pygame.Color, walls: WallList, like: pygame.Surface
+) -> pygame.Surface:
+    # Runs on the worker thread; touches nothing but its own surface
+    px, py, pw, ph = pixels
+    surf = pygame.Surface((pw, ph), 0, like)
+    surf.fill(bg)
+    for rect, color in walls:
+        x, y, w, h = _scaled(rect, scale)
+        pygame.draw.rect(surf, color, (x - px, y - py, w, h))
+    return surf
+
+
+class TileCache:
+    """LRU cache of world-aligned tile surfaces holding the background and walls.
+
+    A frame composites the visible tiles with one blit each. Tiles that are not
+    ready yet (first sight, evicted, or invalidated because walls streamed in or
+    out) are rendered on a worker thread. Meanwhile that tile's walls are drawn
+    directly, so nothing pops in and nothing stalls.
+
+    Tiles are `size` world pixels square and rendered at `scale` pixels per
+    world pixel (the Canvas render scale).
+
+    `budget_bytes` caps the surfaces kept alive; the least recently drawn tiles
+    are dropped first, but never ones visible this frame.
+
+    With the pipelined loop, draw() runs on the render thread while walls come
+    and go on the simulation thread. Callers changing the wall source hold
+    `lock` across the change and its invalidate().
+    """
+
+    def __init__(
+        self,
+        walls_in: Callable[[pygame.Rect], Iterable[pygame.sprite.Sprite]],
+        bg: pygame.Color,
+        like: pygame.Surface,
+        *,
+        size: int = 512,
+        budget_bytes: int = 32 * 1024 * 1024,
+        scale: float = 1.0,
+    ) -> None:
+        self.walls_in = walls_in
+        self.bg = bg
+        # Format template for new tiles, made here so the worker never reads the live screen
+        self.like = pygame.Surface((1, 1), 0, like)
+        self.size = size
+        self.budget_bytes = budget_bytes
+
+        self._tiles: OrderedDict[TileKey, pygame.Surface] = OrderedDict()
+        # Renders are stamped (epoch, generation); set_scale bumps the epoch for every tile at once
+        self._pending: dict[TileKey, tuple[tuple[int, int], Future[pygame.Surface]]] = {}
+        self._generation: dict[TileKey, int] = {}
+        self._epoch = 0
+        self._pool = ThreadPoolExecutor(max_workers=1, thread_name_prefix="tile-render")
+        self.lock = threading.RLock()
+        self._closed = False
+        # draw()'s blit list, reused every frame (draw only runs on the render thread)
+        self._ready: list[tuple[pygame.Surface, tuple[int, int]]] = []
+
+        self.renders = 0
+        self.evictions = 0
+        self.fallbacks = 0
+        self.set_scale(scale)
+
+    def set_scale(self, scale: float) -> None:
+        """Re-render everything at a new scale; old tiles are dropped, in-flight ones ignored."""
+        with self.lock:
+            self.scale = scale
+            side = round(self.size * scale)
+            self.tile_bytes = side * side * self.like.get_bytesize()
+            self._tiles.clear()
+            self._pending.clear()
+            self._epoch += 1
+
+    @property
+    def bytes_used(self) -> int:
+        return len(self._tiles) * self.tile_bytes
+
+    def _rect(self, key: TileKey) -> pygame.Rect:
+        return pygame.Rect(key[0] * self.size, key[1] * self.size, self.size, self.size)
+
+    def _stamp(self, key: TileKey) -> tuple[int, int]:
+        return self._epoch, self._generation.get(key, 0)
+
+    def _keys(self, rect: pygame.Rect) -> list[TileKey]:
+        s = self.size
+        return [
+            (tx, ty)
+            for ty in range(rect.top // s, (rect.bottom - 1) // s + 1)
+            for tx in range(rect.left // s, (rect.right - 1) // s + 1)
+        ]
+
+    def invalidate(self, rect: pygame.Rect) -> None:
+        """Drop tiles overlapping rect (walls there changed); in-flight renders are ignored."""
+        with self.lock:
+            for key in self._keys(rect):
+                self._tiles.pop(key, None)
+                self._pending.pop(key, None)
+                self._generation[key] = self._generation.get(key, 0) + 1
+
+    def _walls(self, tile: pygame.Rect) -> WallList:
+        return [(tuple(w.rect), w.color) for w in self.walls_in(tile)]
+
+    def _request(self, key: TileKey) -> None:
+        if key in self._pending or self._closed:
+            return
+        tile = self._rect(key)
+        pixels = _scaled(tuple(tile), self.scale)
+        future = self._pool.submit(_render, pixels, self.scale, self.bg, self._walls(tile), self.like)
+        self._pending[key] = (self._stamp(key), future)
+
+    def _collect(self) -> None:
+        if not self._pending:
+            return
+        for key, (stamp, future) in list(self._pending.items()):
+            if future.done():
+                del self._pending[key]
+                if stamp == self._stamp(key):
+                    self._tiles[key] = future.result()
+                    self.renders += 1
+
+    def _trim(self, keep: list[TileKey]) -> None:
+        if self.bytes_used <= self.budget_bytes:
+            return
+        keep = set(keep)
+        for key in list(self._tiles):
+            if self.bytes_used <= self.budget_bytes:
+                break
+            if key not in keep:
+                del self._tiles[key]
+                self.evictions += 1
+
+    def visible(self, view: pygame.Rect) -> list[tuple[pygame.Rect, pygame.Surface | None, WallList]]:
+        """Tiles under view as (world rect, surface, walls); walls only where the surface is not ready."""
+        with self.lock:
+            self._collect()
+            keys = self._keys(view)
+            out: list[tuple[pygame.Rect, pygame.Surface | None, WallList]] = []
+            for key in keys:
+                surf = self._tiles.get(key)
+                tile = self._rect(key)
+                if surf is not None:
+                    self._tiles.move_to_end(key)
+                    out.append((tile, surf, _NO_WALLS))
+                    continue
+                self._request(key)
+                self.fallbacks += 1
+                out.append((tile, None, self._walls(tile)))
+            self._trim(keys)
+            return out
+
+    def draw(self, target: pygame.Surface, view: pygame.Rect, offset: tuple[float, float]) -> int:
+        """Composite every tile under view onto target; offset maps world to logical screen coords.
+
+        Ready tiles go out in one blits() call. Returns the number of draw calls made.
+        """
+        k = self.scale
+        # Truncate like Rect.move does, so tiles land exactly where per-wall draws would
+        ox, oy = round(int(offset[0]) * k), round(int(offset[1]) * k)
+        ready = self._ready
+        calls = 1
+        for tile, surf, walls in self.visible(view):
+            x, y, w, h = _scaled(tuple(tile), k)
+            if surf is not None:
+                ready.append((surf, (x + ox, y + oy)))
+                continue
+
+            # Tiles never overlap, so drawing this one out of turn is fine
+            clip = target.get_clip()
+            target.set_clip(pygame.Rect(x + ox, y + oy, w, h).clip(clip))
+            target.fill(self.bg)
+            for rect, color in walls:
+                wx, wy, ww, wh = _scaled(rect, k)
+                pygame.draw.rect(target, color, (wx + ox, wy + oy, ww, wh))
+            target.set_clip(clip)
+            calls += 1 + len(walls)
+        target.blits(ready, doreturn=False)
+        ready.clear()
+        return calls
+
+    def warm(self, view: pygame.Rect) -> None:
+        """Render the tiles under view synchronously (level start, golden captures).
+
+        Does nothing once closed; draw() then falls back to direct wall draws.
+        """
+        with self.lock:
+            if self._closed:
+                return
+            for key in self._keys(view):
+                if key not in self._tiles:
+                    self._request(key)
+                    _, future = self._pending.pop(key)
+                    self._tiles[key] = future.result()
+                    self.renders += 1
+
+    def close(self) -> None:
+        # A snapshot may still draw with this cache; it falls back to direct wall draws
+        with self.lock:
+            self._closed = True
+            self._pool.shutdown(wait=False, cancel_futures=True)
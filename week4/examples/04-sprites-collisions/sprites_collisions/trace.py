@@ -0,0 +1,191 @@
+"""Frame phase tracing: a ring buffer of timed spans, dumped as Chrome trace-event JSON.
+
+Open the dump in chrome://tracing or https://ui.perfetto.dev to see every
+frame's handle_event / update / draw / flip on a timeline, one row per thread.
+
+Spans are stored as complete ("X") events, one slot per span, so a wrapped
+ring never holds a begin without its end. Each slot is 14 bytes in
+preallocated arrays; the default capacity holds an hour at 60 fps with
+room to spare, and memory never grows after startup.
+"""
+
+from __future__ import annotations
+
+import contextlib
+import itertools
+import json
+import logging
+import threading
+import time
+from array import array
+from pathlib import Path
+
+log = logging.getLogger(__name__)
+
+# Spans per frame the default capacity budgets for (a serial frame records about a dozen)
+SPANS_PER_FRAME = 16
+# Durations are stored as 32-bit nanoseconds; longer spans are clamped to ~4.3 s
+_MAX_DUR = 2**32 - 1
+
+
+def capacity_for(minutes: float, fps: int) -> int:
+    """Ring slots needed to keep `minutes` of trace at `fps`."""
+    return int(minutes * 60 * fps * SPANS_PER_FRAME)
+
+
+class _Span:
+    __slots__ = ("tracer", "name", "start")
+
+    def __init__(self, tracer: Tracer, name: str) -> None:
+        self.tracer = tracer
+        self.name = name
+
+    def __enter__(self) -> None:
+        self.start = time.perf_counter_ns()
+
+    def __exit__(self, *exc: object) -> None:
+        self.tracer.record(self.name, self.start, time.perf_counter_ns())
+
+
+class Tracer:
+    """Records named spans from any thread into a fixed-size ring.
+
+        with tracer.span("draw"):
+            ...
+
+    `dump()` writes the ring, oldest span first, to `path` (or a timestamped
+    file next to it) on a background thread, so a hotkey dump does not stall
+    the frame for the whole file write. A dump asked for while the previous
+    one is still being written is skipped rather than waited for.
+    """
+
+    enabled = True
+
+    def __init__(self, path: str | Path, *, capacity: int) -> None:
+        self.path = Path(path)
+        self.capacity = capacity
+        self._t0 = time.perf_counter_ns()
+        self._start = array("q", bytes(8 * capacity))
+        self._dur = array("I", bytes(4 * capacity))
+        self._name = array("B", bytes(capacity))
+        self._tid = array("B", bytes(capacity))
+        # next() on a count is atomic under the GIL, so threads never share a slot
+        self._seq = itertools.count()
+        self._names: dict[str, int] = {}
+        self._threads: dict[int, int] = {}
+        self._thread_names: list[str] = []
+        self._lock = threading.Lock()
+        self._writer: threading.Thread | None = None
+
+    def span(self, name: str) -> _Span:
+        return _Span(self, name)
+
+    def record(self, name: str, start_ns: int, end_ns: int) -> None:
+        i = next(self._seq) % self.capacity
+        name_id = self._names.get(name)
+        if name_id is None:
+            name_id = self._register_name(name)
+        ident = threading.get_ident()
+        tid = self._threads.get(ident)
+        if tid is None:
+            tid = self._register_thread(ident)
+        self._start[i] = start_ns - self._t0
+        self._dur[i] = min(end_ns - start_ns, _MAX_DUR)
+        self._name[i] = name_id
+        self._tid[i] = tid
+
+    # New names and threads are rare; the lock keeps two threads from taking the same id
+
+    def _register_name(self, name: str) -> int:
+        with self._lock:
+            return self._names.setdefault(name, len(self._names))
+
+    def _register_thread(self, ident: int) -> int:
+        with self._lock:
+            if ident not in self._threads:
+                self._thread_names.append(threading.current_thread().name)
+                self._threads[ident] = len(self._thread_names) - 1
+            return self._threads[ident]
+
+    def dump(self, path: str | Path | None = None, *, wait: bool = False) -> Path | None:
+        """Write the ring as trace-event JSON; without a path, next to self.path with a timestamp.
+
+        Returns the path, or None if the previous dump is still being written.
+        `wait` (at exit) waits for that one instead, then for this one.
+        """
+        busy = self._writer is not None and self._writer.is_alive()
+        if busy and not wait:
+            log.info("trace: previous dump still being written, skipping this one")
+            return None
+        if self._writer is not None:
+            self._writer.join()
+        if path is None:
+            path = self.path.with_stem(f"{self.path.stem}-{time.strftime('%H%M%S')}")
+        path = Path(path)
+
+        # Copy first (a few memcpys) so the frame can go on while the file is written
+        t = time.perf_counter_ns()
+        count = next(self._seq)
+        data = (self._start[:], self._dur[:], self._name[:], self._tid[:])
+        # The slot count took holds this dump's own span, so later dumps find no blank event there
+        i = count % self.capacity
+        self._start[i] = t - self._t0
+        self._dur[i] = min(time.perf_counter_ns() - t, _MAX_DUR)
+        self._name[i] = self._register_name("trace.dump")
+        self._tid[i] = self._register_thread(threading.get_ident())
+        if count > self.capacity:
+            # Oldest first; skip a few slots that threads may have overwritten during the copy
+            first, n = (count + 64) % self.capacity, self.capacity - 64
+        else:
+            first, n = 0, count
+        names = list(self._names)
+        threads = list(self._thread_names)
+
+        self._writer = threading.Thread(
+            target=self._write, args=(path, data, first, n, names, threads), name="TraceWriter"
+        )
+        self._writer.start()
+        if wait:
+            self._writer.join()
+        return path
+
+    def _write(
+        self, path: Path, data: tuple[array, ...], first: int, n: int, names: list[str], threads: list[str]
+    ) -> None:
+        start, dur, name, tid = data
+        quoted = [json.dumps(s) for s in names]
+        cap = self.capacity
+        with open(path, "w") as f:
+            f.write('{"displayTimeUnit":"ms","traceEvents":[\n')
+            for t, thread in enumerate(threads):
+                f.write(f'{{"ph":"M","name":"thread_name","pid":1,"tid":{t},"args":{{"name":{json.dumps(thread)}}}}},\n')
+            lines = []
+            for k in range(n):
+                i = (first + k) % cap
+                lines.append(
+                    f'{{"ph":"X","name":{quoted[name[i]]},"pid":1,"tid":{tid[i]},'
+                    f'"ts":{start[i] / 1000:.3f},"dur":{dur[i] / 1000:.3f}}}'
+                )
+                if len(lines) >= 10000:
+                    f.write(",\n".join(lines) + ",\n")
+                    lines.clear()
+            # Trailing metadata event keeps the list valid JSON without tracking the last comma
+            lines.append('{"ph":"M","name":"process_name","pid":1,"args":{"name":"sprites_collisions"}}')
+            f.write(",\n".join(lines) + "\n]}\n")
+        log.info("trace: wrote %d spans to %s", n, path)
+
+
+class NullTracer:
+    """Stand-in when tracing is off: span() hands back one shared no-op context."""
+
+    enabled = False
+    _NULL = contextlib.nullcontext()
+
+    def span(self, name: str) -> contextlib.nullcontext:
+        return self._NULL
+
+    def dump(self, path: str | Path | None = None, *, wait: bool = False) -> None:
+        return None
+
+
+OFF = NullTracer()